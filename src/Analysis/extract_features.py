@@ -12,7 +12,8 @@ from collections.abc import Callable
 from datetime import datetime
 from extract_features_parallel import do_parallel_feature_extraction
 from feature_extraction_cpp import (extraction_params_file, FeatureData, feature_directory, SampleId,
-                                    VtkImageMaskPair, VtkImageData, VtkType_Short, VtkType_Float)
+                                    VtkImageMaskPair, VtkImageData, VtkType_Short, VtkType_Float,
+                                    VtkType_UnsignedChar)
 from multiprocessing import Manager
 from pathlib import Path
 from radiomics import featureextractor
@@ -42,7 +43,7 @@ def vtk_to_sitk_image(vtk_image: VtkImageData) -> sitk.Image:
     spacing = vtk_image.get_spacing()
 
     vtk_data_type: int = vtk_image.get_data_type()
-    vtk_to_np_type_dict = {VtkType_Short: np.short, VtkType_Float: np.float32}
+    vtk_to_np_type_dict = {VtkType_Short: np.short, VtkType_Float: np.float32, VtkType_UnsignedChar: np.uint8}
     np_data_type = vtk_to_np_type_dict[vtk_data_type]
 
     np_data = np.frombuffer(vtk_image, dtype=np_data_type)
@@ -2,6 +2,7 @@
 
 #include "Artifacts/PipelineList.h"
 #include "DataInitializer.h"
+#include "Modeling/BaseVolumeCache.h"
 #include "Modeling/ImplicitCtDataSource.h"
 #include "Modeling/CtStructureTree.h"
 #include "Modeling/NrrdCtDataSource.h"
@@ -30,6 +31,7 @@ App::App(int argc, char* argv[]) :
             dataSource->SetDataTree(CtDataTree.get());
             return dataSource;
         }()),
+        BaseVolumes(std::make_unique<BaseVolumeCache>()),
         Pipelines(new PipelineList(*CtDataTree)),
         PipelineGroups([&pipelines = *Pipelines] {
             auto* const pipelineGroupList = new PipelineGroupList(pipelines);
@@ -124,6 +126,10 @@ auto App::SetCtDataSource(CtDataSource& ctDataSource) -> void {
     MainWindow_->UpdateDataSource(ctDataSource);
 }
 
+auto App::GetBaseVolumeCache() const -> BaseVolumeCache& {
+    return *BaseVolumes;
+}
+
 auto App::GetCtDataSourceType() const -> CtDataSourceType {
     if (dynamic_cast<ImplicitCtDataSource*>(DataSource.Get()))
         return CtDataSourceType::IMPLICIT;
@@ -5,6 +5,7 @@
 
 #include <memory>
 
+class BaseVolumeCache;
 class CtDataSource;
 class CtStructureTree;
 class MainWindow;
@@ -50,6 +51,10 @@ public:
     [[nodiscard]] auto
     GetCtDataSourceType() const -> CtDataSourceType;
 
+    /** Snapshot of the data source's volume shared by all pipelines generating images */
+    [[nodiscard]] auto
+    GetBaseVolumeCache() const -> BaseVolumeCache&;
+
     [[nodiscard]] auto
     GetImageDimensions() const -> std::array<uint32_t, 3>;
 
@@ -79,6 +84,7 @@ private:
     std::unique_ptr<QApplication> QApp;
     std::unique_ptr<CtStructureTree> CtDataTree;
     vtkSmartPointer<CtDataSource> DataSource;
+    std::unique_ptr<BaseVolumeCache> BaseVolumes;
     vtkNew<ThresholdFilter> ThresholdFilterAlgorithm;
     std::unique_ptr<PipelineList> Pipelines;
     std::unique_ptr<PipelineGroupList> PipelineGroups;
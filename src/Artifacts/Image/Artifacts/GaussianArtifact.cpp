@@ -26,6 +26,11 @@ auto GaussianArtifact::GetFilter() const -> vtkImageAlgorithm& {
     return *Filter;
 }
 
+auto GaussianArtifact::SetNoiseSeed(uint64_t seed, uint32_t streamId) const -> void {
+    Filter->SetSeed(seed);
+    Filter->SetStreamId(streamId);
+}
+
 auto GaussianArtifactData::PopulateFromArtifact(const GaussianArtifact& artifact) noexcept -> void {
     Mean = artifact.Mean;
     Sd = artifact.Sd;
@@ -31,6 +31,11 @@ auto SaltPepperArtifact::GetFilter() const -> vtkImageAlgorithm& {
     return *Filter;
 }
 
+auto SaltPepperArtifact::SetNoiseSeed(uint64_t seed, uint32_t streamId) const -> void {
+    Filter->SetSeed(seed);
+    Filter->SetStreamId(streamId);
+}
+
 auto SaltPepperArtifactData::PopulateFromArtifact(const SaltPepperArtifact& artifact) noexcept -> void {
     SaltAmount = artifact.SaltAmount;
     PepperAmount = artifact.PepperAmount;
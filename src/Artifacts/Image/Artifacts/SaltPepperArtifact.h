@@ -44,6 +44,10 @@ public:
     [[nodiscard]] auto
     GetFilter() const -> vtkImageAlgorithm&;
 
+    /** Sets the seed and stream the filter draws its noise from, e.g. per sample and artifact */
+    auto
+    SetNoiseSeed(uint64_t seed, uint32_t streamId) const -> void;
+
     [[nodiscard]] auto
     GetProperties() noexcept -> PipelineParameterProperties {
         PipelineParameterProperties properties;
@@ -1,5 +1,6 @@
 #include "BasicImageArtifact.h"
 
+#include "Filters/PointwiseImageArtifactFilter.h"
 #include "../../Utils/Overload.h"
 #include "../../Utils/LinearAlgebraTypes.h"
 
@@ -142,3 +143,16 @@ auto BasicImageArtifact::AppendImageFilters(vtkImageAlgorithm& inputAlgorithm) -
         return filter;
     }, Artifact);
 }
+
+auto BasicImageArtifact::GetPointwiseFilter() -> PointwiseImageArtifactFilter* {
+    return std::visit([](auto& artifact) { return PointwiseImageArtifactFilter::SafeDownCast(&artifact.GetFilter()); },
+                      Artifact);
+}
+
+auto BasicImageArtifact::SetNoiseSeed(uint64_t seed, uint32_t streamId) const -> void {
+    std::visit(Overload {
+            [=](GaussianArtifact const& artifact)   { artifact.SetNoiseSeed(seed, streamId); },
+            [=](SaltPepperArtifact const& artifact) { artifact.SetNoiseSeed(seed, streamId); },
+            [](auto const&) {}
+    }, Artifact);
+}
@@ -17,6 +17,7 @@
 #include <string>
 
 class BasicImageArtifact;
+class PointwiseImageArtifactFilter;
 
 #define BASIC_IMAGE_ARTIFACT_TYPES \
 GaussianArtifact, SaltPepperArtifact, RingArtifact, CuppingArtifact, WindMillArtifact, StairStepArtifact
@@ -114,6 +115,14 @@ public:
     auto
     AppendImageFilters(vtkImageAlgorithm& inputAlgorithm) -> vtkImageAlgorithm&;
 
+    /** Filter of the artifact if it is pointwise and can be fused with adjacent pointwise artifacts, else nullptr */
+    [[nodiscard]] auto
+    GetPointwiseFilter() -> PointwiseImageArtifactFilter*;
+
+    /** Sets the seed and stream of the random noise, if the artifact is a noise artifact */
+    auto
+    SetNoiseSeed(uint64_t seed, uint32_t streamId) const -> void;
+
 private:
     [[nodiscard]] auto static
     GetSubType(const BasicImageArtifactVariant& artifact) noexcept -> SubType;
@@ -2,6 +2,7 @@
 
 #include "ImageArtifact.h"
 
+#include "Filters/FusedImageArtifactFilter.h"
 #include "Filters/MergeParallelImageArtifactFilters.h"
 
 #include <QComboBox>
@@ -179,9 +180,37 @@ auto CompositeImageArtifact::AppendImageFilters(vtkImageAlgorithm& inputAlgorith
 
         case CompositionType::SEQUENTIAL: {
             vtkImageAlgorithm* currentImageAlgorithm = &inputAlgorithm;
+            size_t numberOfFusedFilters = 0;
+
+            for (auto artifactIt = ImageArtifacts.begin(); artifactIt != ImageArtifacts.end();) {
+                // consecutive pointwise artifacts are applied in a single pass
+                std::vector<PointwiseImageArtifactFilter*> pointwiseFilters;
+                for (auto it = artifactIt; it != ImageArtifacts.end(); ++it) {
+                    auto* pointwiseFilter = (*it)->GetPointwiseFilter();
+                    if (!pointwiseFilter)
+                        break;
+
+                    pointwiseFilters.push_back(pointwiseFilter);
+                }
+
+                if (pointwiseFilters.size() < 2) {
+                    currentImageAlgorithm = &(*artifactIt)->AppendImageFilters(*currentImageAlgorithm);
+                    ++artifactIt;
+                    continue;
+                }
+
+                if (numberOfFusedFilters == FusedFilters.size())
+                    FusedFilters.emplace_back(vtkSmartPointer<FusedImageArtifactFilter>::New());
+
+                FusedImageArtifactFilter& fusedFilter = *FusedFilters[numberOfFusedFilters++];
+                fusedFilter.SetFilters(pointwiseFilters);
+                fusedFilter.SetInputConnection(currentImageAlgorithm->GetOutputPort());
+
+                currentImageAlgorithm = &fusedFilter;
+                std::advance(artifactIt, pointwiseFilters.size());
+            }
 
-            for (auto const& imageArtifact : ImageArtifacts)
-                currentImageAlgorithm = &imageArtifact->AppendImageFilters(*currentImageAlgorithm);
+            FusedFilters.resize(numberOfFusedFilters);
 
             return *currentImageAlgorithm;
         }
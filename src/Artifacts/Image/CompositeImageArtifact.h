@@ -8,7 +8,9 @@
 #include <QWidget>
 
 #include <vtkNew.h>
+#include <vtkSmartPointer.h>
 
+class FusedImageArtifactFilter;
 class MergeParallelImageArtifactFilters;
 
 class QComboBox;
@@ -139,6 +141,7 @@ private:
     CompositionType CompType = CompositionType::SEQUENTIAL;
 
     vtkNew<MergeParallelImageArtifactFilters> Filter;
+    mutable std::vector<vtkSmartPointer<FusedImageArtifactFilter>> FusedFilters; // one per run of pointwise artifacts
 };
 
 
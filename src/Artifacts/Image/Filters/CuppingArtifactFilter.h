@@ -1,14 +1,15 @@
 #pragma once
 
-#include "ImageArtifactFilter.h"
+#include "PointwiseImageArtifactFilter.h"
+#include "SliceCoordinateTable.h"
 
-class CuppingArtifactFilter : public ImageArtifactFilter {
+class CuppingArtifactFilter : public PointwiseImageArtifactFilter {
 public:
     CuppingArtifactFilter(const CuppingArtifactFilter&) = delete;
     void operator=(const CuppingArtifactFilter&) = delete;
 
     static CuppingArtifactFilter* New();
-    vtkTypeMacro(CuppingArtifactFilter, ImageArtifactFilter);
+    vtkTypeMacro(CuppingArtifactFilter, PointwiseImageArtifactFilter);
     void PrintSelf(ostream& os, vtkIndent indent) override;
 
     vtkSetClampMacro(MinRadiodensityFactor, float, 0.0, 1.0);
@@ -24,36 +25,28 @@ public:
     [[nodiscard]] auto
     GetCenterPoint() const -> std::array<float, 3> { return Center; }
 
+    [[nodiscard]] auto
+    GetSubType() const noexcept -> SubType override { return SubType::CUPPING; }
+
+    [[nodiscard]] auto
+    CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> override;
+
 protected:
     CuppingArtifactFilter() = default;
     ~CuppingArtifactFilter() override = default;
 
-    int RequestInformation(vtkInformation *request,
-                           vtkInformationVector **inputVector,
-                           vtkInformationVector *outputVector) override;
-
-    auto
-    ExecuteDataWithImageInformation(vtkImageData* input, vtkImageData* output, vtkInformation* outInfo) -> void override;
-
-    struct Algorithm {
-        CuppingArtifactFilter* Self;
-        vtkImageData* VolumeData;
-        std::array<double, 3> Spacing;
-        std::array<int, 3> UpdateDims;
-        DoublePoint StartPoint;
-        float const* Radiodensities;
-        float* ArtifactValues;
+    struct Algorithm : Kernel {
         float MinRadiodensityFactor;
         float RadiodensityFactorRange;
         FloatPoint Center;
         float xyMaxDistance;
+        std::shared_ptr<SliceCoordinateTable const> Radii;
 
-        Algorithm(CuppingArtifactFilter* self,
-                  vtkImageData* volumeData,
-                  float const* radiodensities,
-                  float* artifactValues);
+        Algorithm(CuppingArtifactFilter* self, vtkImageData& volume);
 
-        void operator()(vtkIdType pointId, vtkIdType endPointId) const;
+        auto
+        EvaluateRow(ImageDataUtils::Row const& row,
+                    std::span<float const> radiodensities, std::span<float> artifactValues) const -> void override;
     };
 
     float MinRadiodensityFactor = 0.0F;
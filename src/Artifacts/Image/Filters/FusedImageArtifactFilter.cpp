@@ -0,0 +1,50 @@
+#include "FusedImageArtifactFilter.h"
+
+#include <vtkObjectFactory.h>
+
+#include <algorithm>
+
+vtkStandardNewMacro(FusedImageArtifactFilter)
+
+auto FusedImageArtifactFilter::SetFilters(std::vector<PointwiseImageArtifactFilter*> const& filters) -> void {
+    if (std::ranges::equal(Filters, filters,
+                           [](auto const& filter, PointwiseImageArtifactFilter* other) { return filter == other; }))
+        return;
+
+    Filters.assign(filters.begin(), filters.end());
+
+    Modified();
+}
+
+auto FusedImageArtifactFilter::GetMTime() -> vtkMTimeType {
+    vtkMTimeType mTime = Superclass::GetMTime();
+
+    for (auto const& filter : Filters)
+        mTime = std::max(mTime, filter->GetMTime());
+
+    return mTime;
+}
+
+auto FusedImageArtifactFilter::RequestInformation(vtkInformation* request,
+                                                  vtkInformationVector** inputVector,
+                                                  vtkInformationVector* outputVector) -> int {
+    ImageArtifactFilter::RequestInformation(request, inputVector, outputVector);
+
+    if (!OutputArtifactArrays)
+        return 1;
+
+    for (auto const& filter : Filters)
+        AddArrayInformationToPointDataVector(filter->GetSubType(), outputVector);
+
+    return 1;
+}
+
+void FusedImageArtifactFilter::ExecuteDataWithImageInformation(vtkImageData* input,
+                                                               vtkImageData* output,
+                                                               vtkInformation* outInfo) {
+    std::vector<PointwiseImageArtifactFilter*> filters;
+    std::ranges::transform(Filters, std::back_inserter(filters),
+                           [](auto const& filter) { return filter.Get(); });
+
+    PointwiseImageArtifactFilter::ExecuteKernels(*this, *output, filters);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "PointwiseImageArtifactFilter.h"
+
+#include <vtkSmartPointer.h>
+
+#include <vector>
+
+/**
+ * Applies the artifacts of consecutive pointwise image artifact filters in a single pass over the volume.
+ * The fused filters are not executed themselves, they only provide their parameters.
+ */
+class FusedImageArtifactFilter : public ImageArtifactFilter {
+public:
+    FusedImageArtifactFilter(const FusedImageArtifactFilter&) = delete;
+    void operator=(const FusedImageArtifactFilter&) = delete;
+
+    static FusedImageArtifactFilter* New();
+    vtkTypeMacro(FusedImageArtifactFilter, ImageArtifactFilter);
+
+    /** Sets the filters whose artifacts are applied in the given order */
+    auto
+    SetFilters(std::vector<PointwiseImageArtifactFilter*> const& filters) -> void;
+
+    vtkMTimeType GetMTime() override;
+
+protected:
+    FusedImageArtifactFilter() = default;
+    ~FusedImageArtifactFilter() override = default;
+
+    int RequestInformation(vtkInformation *request,
+                           vtkInformationVector **inputVector,
+                           vtkInformationVector *outputVector) override;
+
+    auto
+    ExecuteDataWithImageInformation(vtkImageData* input, vtkImageData* output, vtkInformation* outInfo) -> void override;
+
+private:
+    std::vector<vtkSmartPointer<PointwiseImageArtifactFilter>> Filters;
+};
@@ -1,14 +1,9 @@
 #include "GaussianArtifactFilter.h"
 
-#include <vtkFloatArray.h>
 #include <vtkImageData.h>
-#include <vtkInformation.h>
 #include <vtkObjectFactory.h>
-#include <vtkPointData.h>
-#include <vtkSMPTools.h>
 
-#include <random>
-#include <span>
+#include <algorithm>
 
 vtkStandardNewMacro(GaussianArtifactFilter)
 
@@ -17,55 +12,31 @@ void GaussianArtifactFilter::PrintSelf(ostream &os, vtkIndent indent) {
 
     os << indent << "Mean: " << Mean << "]\n";
     os << indent << "Standard Deviation: " << Sd << "]\n";
+    os << indent << "Seed: " << Seed << ", Stream: " << StreamId << "\n";
 }
 
-auto GaussianArtifactFilter::RequestInformation(vtkInformation* request,
-                                                vtkInformationVector** inputVector,
-                                                vtkInformationVector *outputVector) -> int {
-    ImageArtifactFilter::RequestInformation(request, inputVector, outputVector);
-
-    AddArrayInformationToPointDataVector(SubType::GAUSSIAN, outputVector);
-
-    return 1;
+auto GaussianArtifactFilter::CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> {
+    return std::make_unique<Algorithm>(this, volume);
 }
 
-void GaussianArtifactFilter::ExecuteDataWithImageInformation(vtkImageData* input,
-                                                             vtkImageData* output,
-                                                             vtkInformation* outInfo) {
-    vtkIdType const numberOfPoints = output->GetNumberOfPoints();
-
-    vtkNew<vtkFloatArray> const newNoiseValueArray;
-    newNoiseValueArray->SetNumberOfComponents(1);
-    newNoiseValueArray->SetNumberOfTuples(output->GetNumberOfPoints());
-    newNoiseValueArray->FillValue(0.0F);
-    float* newNoiseValues = newNoiseValueArray->WritePointer(0, numberOfPoints);
-    std::span const newNoiseValueSpan { newNoiseValues, static_cast<size_t>(numberOfPoints) };
-
-    static unsigned int seed = 0;
-    std::normal_distribution normalDistribution { static_cast<float>(Mean),
-                                                         static_cast<float>(Sd) };
-    std::mt19937 engine { ++seed };
-
-    std::ranges::generate(newNoiseValueSpan,
-                          [&] { return normalDistribution(engine); });
-
-    vtkFloatArray* radioDensityArray = GetRadiodensitiesArray(output);
-    float* radiodensities = radioDensityArray->WritePointer(0, numberOfPoints);
-
-    vtkFloatArray* gaussianNoiseArray = GetDeepCopiedArtifactArray(input, output, SubType::GAUSSIAN);
-    float* gaussianNoiseValues = gaussianNoiseArray->WritePointer(0, numberOfPoints);
-
-    auto addNoiseValues = [noiseValues = gaussianNoiseValues,
-                           newNoiseValues = newNoiseValues,
-                           radiodensities = radiodensities] (vtkIdType pointId, vtkIdType endPointId) {
-        vtkIdType const startPointId = pointId;
-
-        for (; pointId < endPointId; pointId++)
-            radiodensities[pointId] += newNoiseValues[pointId];
-
-        pointId = startPointId;
-        for (; pointId < endPointId; pointId++)
-            noiseValues[pointId] += newNoiseValues[pointId];
-    };
-    vtkSMPTools::For(0, numberOfPoints, addNoiseValues);
+GaussianArtifactFilter::Algorithm::Algorithm(GaussianArtifactFilter* self, vtkImageData& volume) :
+        Kernel(volume),
+        RandomStream(self->GetSeed(), self->GetStreamId()),
+        Mean(static_cast<float>(self->GetMean())),
+        Sd(static_cast<float>(self->GetSd())) {}
+
+auto GaussianArtifactFilter::Algorithm::EvaluateRow(ImageDataUtils::Row const& row,
+                                                    std::span<float const> /*radiodensities*/,
+                                                    std::span<float> artifactValues) const -> void {
+    // the noise of voxel i is value i % 4 of block i / 4, independent of how the volume is split into rows
+    vtkIdType const endPointId = row.PointId + static_cast<vtkIdType>(artifactValues.size());
+
+    for (vtkIdType blockStartId = row.PointId - row.PointId % 4; blockStartId < endPointId; blockStartId += 4) {
+        std::array<float, 4> const noiseValues = RandomStream.Normal(blockStartId / 4, Mean, Sd);
+
+        for (vtkIdType pointId = std::max(blockStartId, row.PointId);
+             pointId < std::min(blockStartId + 4, endPointId);
+             pointId++)
+            artifactValues[pointId - row.PointId] = noiseValues[pointId - blockStartId];
+    }
 }
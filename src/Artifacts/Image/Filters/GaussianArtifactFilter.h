@@ -1,11 +1,12 @@
 #pragma once
 
-#include "ImageArtifactFilter.h"
+#include "PointwiseImageArtifactFilter.h"
+#include "../../../Utils/CounterBasedRandom.h"
 
-class GaussianArtifactFilter : public ImageArtifactFilter {
+class GaussianArtifactFilter : public PointwiseImageArtifactFilter {
 public:
     static GaussianArtifactFilter* New();
-    vtkTypeMacro(GaussianArtifactFilter, ImageArtifactFilter);
+    vtkTypeMacro(GaussianArtifactFilter, PointwiseImageArtifactFilter);
     void PrintSelf(ostream& os, vtkIndent indent) override;
 
     vtkSetClampMacro(Mean, double, -1000.0, 3000.0);
@@ -14,22 +15,41 @@ public:
     vtkSetClampMacro(Sd, double, 0.0000001, 1000.0);
     vtkGetMacro(Sd, double);
 
+    /** The noise is a function of the seed, the stream and the voxel index */
+    vtkSetMacro(Seed, vtkTypeUInt64);
+    vtkGetMacro(Seed, vtkTypeUInt64);
+
+    vtkSetMacro(StreamId, vtkTypeUInt32);
+    vtkGetMacro(StreamId, vtkTypeUInt32);
+
     GaussianArtifactFilter(const GaussianArtifactFilter&) = delete;
     void operator=(const GaussianArtifactFilter&) = delete;
 
+    [[nodiscard]] auto
+    GetSubType() const noexcept -> SubType override { return SubType::GAUSSIAN; }
+
+    [[nodiscard]] auto
+    CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> override;
+
 protected:
     GaussianArtifactFilter() = default;
     ~GaussianArtifactFilter() override = default;
 
-    int RequestInformation(vtkInformation *request,
-                           vtkInformationVector **inputVector,
-                           vtkInformationVector *outputVector) override;
+    struct Algorithm : Kernel {
+        CounterBasedRandom::Stream RandomStream;
+        float Mean;
+        float Sd;
+
+        Algorithm(GaussianArtifactFilter* self, vtkImageData& volume);
 
-    auto
-    ExecuteDataWithImageInformation(vtkImageData* input,
-                                    vtkImageData* output,
-                                    vtkInformation* outInfo) -> void override;
+        auto
+        EvaluateRow(ImageDataUtils::Row const& row,
+                    std::span<float const> radiodensities, std::span<float> artifactValues) const -> void override;
+    };
 
     double Mean = 0.0;
     double Sd = 1.0;
+
+    vtkTypeUInt64 Seed = 0;
+    vtkTypeUInt32 StreamId = 0;
 };
@@ -44,10 +44,9 @@ auto ImageArtifactFilter::RequestData(vtkInformation* request,
 
     output->SetExtent(input->GetExtent());
 
+    // arrays are passed on by reference, filters copy the ones they modify on first write
     output->GetPointData()->PassData(input->GetPointData());
 
-    static_cast<void>(GetDeepCopiedRadiodensitiesArray(input, output));
-
     SetErrorCode(vtkErrorCode::NoError);
 
     ExecuteDataWithImageInformation(input, output, outInfo);
@@ -104,15 +103,8 @@ auto ImageArtifactFilter::GetRadiodensitiesArray(vtkImageData* imageData) noexce
     return vtkFloatArray::SafeDownCast(imageData->GetPointData()->GetAbstractArray("Radiodensities"));
 }
 
-auto ImageArtifactFilter::GetDeepCopiedRadiodensitiesArray(vtkImageData* input, vtkImageData* output) noexcept
-        -> vtkFloatArray* {
-
-    vtkNew<vtkFloatArray> copiedRadiodensities;
-    copiedRadiodensities->DeepCopy(GetRadiodensitiesArray(input));
-
-    output->GetPointData()->AddArray(copiedRadiodensities);
-
-    return copiedRadiodensities;
+auto ImageArtifactFilter::GetRadiodensities(vtkImageData* output) -> CopyOnWriteArray {
+    return { *output->GetPointData(), "Radiodensities", output->GetNumberOfPoints() };
 }
 
 auto ImageArtifactFilter::GetArtifactArray(vtkImageData* imageData, SubType subType) noexcept -> vtkFloatArray* {
@@ -125,22 +117,8 @@ auto ImageArtifactFilter::GetArtifactArray(vtkImageData* imageData, SubType subT
     return AddArtifactArray(imageData, subType);
 }
 
-auto ImageArtifactFilter::GetDeepCopiedArtifactArray(vtkImageData* input,
-                                                     vtkImageData* output,
-                                                     SubType subType) noexcept -> vtkFloatArray* {
-    vtkFloatArray* artifactArray = vtkFloatArray::SafeDownCast(
-            input->GetPointData()->GetAbstractArray(GetArrayName(subType).data()));
-
-    if (artifactArray) {
-        vtkNew<vtkFloatArray> copiedArtifactArray;
-        copiedArtifactArray->DeepCopy(artifactArray);
-
-        output->GetPointData()->AddArray(copiedArtifactArray);
-
-        return copiedArtifactArray;
-    }
-
-    return AddArtifactArray(output, subType);
+auto ImageArtifactFilter::GetArtifactValues(vtkImageData* output, SubType subType) -> CopyOnWriteArray {
+    return { *output->GetPointData(), GetArrayName(subType), output->GetNumberOfPoints() };
 }
 
 void ImageArtifactFilter::ExecuteDataWithInformation(vtkDataObject* output, vtkInformation* outInfo) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../BasicImageArtifact.h"
+#include "../../../Utils/CopyOnWriteArray.h"
 
 #include <vtkImageAlgorithm.h>
 
@@ -11,6 +12,15 @@ protected:
     using SubType = BasicImageArtifact::SubType;
 
 public:
+    vtkAbstractTypeMacro(ImageArtifactFilter, vtkImageAlgorithm)
+
+    /**
+     * Sets whether the artifact values of each sub type are output as separate arrays.
+     * Otherwise, the artifacts are only added to the radiodensities and the arrays are never allocated.
+     */
+    vtkSetMacro(OutputArtifactArrays, bool)
+    vtkGetMacro(OutputArtifactArrays, bool)
+
     auto static
     AddArrayInformationToPointDataVector(SubType subType,
                                          vtkInformationVector* outputVector) -> void;
@@ -30,14 +40,16 @@ protected:
     [[nodiscard]] auto static
     GetRadiodensitiesArray(vtkImageData* imageData) noexcept -> vtkFloatArray*;
 
+    /** Radiodensities of the output, shared with the input until they are written to */
     [[nodiscard]] auto static
-    GetDeepCopiedRadiodensitiesArray(vtkImageData* input, vtkImageData* output) noexcept -> vtkFloatArray*;
+    GetRadiodensities(vtkImageData* output) -> CopyOnWriteArray;
 
     [[nodiscard]] auto static
     GetArtifactArray(vtkImageData* imageData, SubType subType) noexcept -> vtkFloatArray*;
 
+    /** Artifact values of the given sub type of the output, shared with the input until they are written to */
     [[nodiscard]] auto static
-    GetDeepCopiedArtifactArray(vtkImageData* input, vtkImageData* output, SubType subType) noexcept -> vtkFloatArray*;
+    GetArtifactValues(vtkImageData* output, SubType subType) -> CopyOnWriteArray;
 
     [[nodiscard]] auto static
     PointDataInformationVectorHasArray(vtkInformation* info, SubType subType) -> bool;
@@ -47,13 +59,15 @@ protected:
 
     auto CreateDefaultExecutive() -> vtkExecutive* override;
 
+    [[nodiscard]] auto static
+    GetArrayName(SubType subType) noexcept -> std::string;
+
     ImageArtifactFilter() = default;
     ~ImageArtifactFilter() override = default;
 
-private:
-    [[nodiscard]] auto static
-    GetArrayName(SubType subType) noexcept -> std::string;
+    bool OutputArtifactArrays = true;
 
+private:
     [[nodiscard]] auto static
     AddArtifactArray(vtkImageData* imageData, SubType subType) noexcept -> vtkFloatArray*;
 };
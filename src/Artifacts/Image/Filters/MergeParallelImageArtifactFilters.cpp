@@ -1,5 +1,7 @@
 #include "MergeParallelImageArtifactFilters.h"
 
+#include "../../../Utils/ImageDataUtils.h"
+
 #include <vtkErrorCode.h>
 #include <vtkFloatArray.h>
 #include <vtkImageData.h>
@@ -7,7 +9,6 @@
 #include <vtkInformationVector.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
-#include <vtkSMPTools.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
 
 vtkStandardNewMacro(MergeParallelImageArtifactFilters)
@@ -51,6 +52,9 @@ int MergeParallelImageArtifactFilters::RequestInformation(vtkInformation* reques
 
     outInfo->Set(CAN_PRODUCE_SUB_EXTENT(), 1);
 
+    if (!OutputArtifactArrays)
+        return 1;
+
     for (std::vector<SubType> const containedSubTypes = GetContainedSubTypes(baseInInfo, parallelInInfos);
          const auto subType : containedSubTypes)
         AddArrayInformationToPointDataVector(subType, outputVector);
@@ -73,77 +77,59 @@ int MergeParallelImageArtifactFilters::RequestData(vtkInformation* request,
     }
     vtkImageData* output = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
     output->SetExtent(baseInput->GetExtent());
-    vtkIdType const numberOfPoints = output->GetNumberOfPoints();
 
     vtkPointData* outputPointData = output->GetPointData();
     outputPointData->PassData(baseInput->GetPointData());
 
-    std::vector<SubType> containedSubTypes = GetContainedSubTypes(baseInInfo, parallelInInfos);
+    std::vector<SubType> const containedSubTypes = OutputArtifactArrays
+            ? GetContainedSubTypes(baseInInfo, parallelInInfos)
+            : std::vector<SubType> {};
 
-    std::vector<vtkFloatArray*> outputArrays;
+    std::vector<CopyOnWriteArray> outputArrays;
     std::ranges::transform(containedSubTypes, std::back_inserter(outputArrays),
-                           [&, baseInput, output](SubType subType) { return GetDeepCopiedArtifactArray(baseInput, output, subType); });
-    outputArrays.push_back(GetDeepCopiedRadiodensitiesArray(baseInput, output));
-
-    std::vector<float*> artifactArrayWritePointers;
-    std::ranges::transform(outputArrays, std::back_inserter(artifactArrayWritePointers),
-                           [=](vtkFloatArray* array) { return array->WritePointer(0, numberOfPoints); });
-
-    std::vector<std::vector<vtkFloatArray*>> inputArrays;
-    std::ranges::transform(containedSubTypes, std::back_inserter(inputArrays),
-                           [&, parallelInInfos](SubType subType) {
-                               std::vector<vtkFloatArray*> subTypeInputArrays;
+                           [output](SubType subType) { return GetArtifactValues(output, subType); });
+    outputArrays.push_back(GetRadiodensities(output));
 
-                               for (int i = 0; i < parallelInInfos->GetNumberOfInformationObjects(); i++) {
-                                   if (vtkInformation* parallelInfo = parallelInInfos->GetInformationObject(i);
-                                       PointDataInformationVectorHasArray(parallelInfo, subType))
-                                       subTypeInputArrays.push_back(GetArtifactArray(parallelInputs[i], subType));
-                               }
+    std::vector<std::string> arrayNames;
+    std::ranges::transform(containedSubTypes, std::back_inserter(arrayNames), &GetArrayName);
+    arrayNames.emplace_back("Radiodensities");
 
-                               return subTypeInputArrays;
-                           });
-    std::vector<vtkFloatArray*> inputRadiodensityArrays;
-    std::ranges::transform(parallelInputs, std::back_inserter(inputRadiodensityArrays),
-                           [&](vtkImageData* parallelInput) { return GetRadiodensitiesArray(parallelInput); });
-    inputArrays.push_back(inputRadiodensityArrays);
-
-
-    std::vector<std::vector<const float*>> inputArrayReadPointers;
-    std::ranges::transform(inputArrays, std::back_inserter(inputArrayReadPointers),
-                           [=](std::vector<vtkFloatArray*> subTypeInputArrays) {
-                               std::vector<const float*> subTypeReadPointers;
-                               std::ranges::transform(subTypeInputArrays, std::back_inserter(subTypeReadPointers),
-                                                      [=](vtkFloatArray* array) { return array->WritePointer(0, numberOfPoints); });
-                               return subTypeReadPointers;
-                           });
+    // every output array is the base array plus the sum of the branches' deltas to it
+    struct MergedArray {
+        CopyOnWriteArray::OverwritePass Output;
+        std::vector<float const*> Branches; // only the branches that modified the array
+    };
+    std::vector<MergedArray> mergedArrays;
+    for (int i = 0; i < outputArrays.size(); i++) {
+        float const* const baseValues = outputArrays[i].GetValues();
 
+        std::vector<float const*> branches;
+        for (auto* parallelInput : parallelInputs) {
+            auto* branchArray = vtkFloatArray::SafeDownCast(
+                    parallelInput->GetPointData()->GetAbstractArray(arrayNames[i].c_str()));
 
-    auto addInputArrayDeltasToOutputArrays = [artifactArrayWritePointers, inputArrayReadPointers]
-    (vtkIdType pointId, vtkIdType endPointId) {
-        vtkIdType const startPointId = pointId;
+            if (branchArray && branchArray->GetPointer(0) != baseValues)
+                branches.push_back(branchArray->GetPointer(0));
+        }
 
-        for (int i = 0; i < artifactArrayWritePointers.size(); ++i) {
-            float* outArray = artifactArrayWritePointers[i];
-            std::vector<float const*> const& inArrays = inputArrayReadPointers[i];
+        // arrays that no branch modified stay shared with the base input
+        if (!branches.empty())
+            mergedArrays.push_back({ outputArrays[i].Overwrite(), std::move(branches) });
+    }
 
-            std::vector<float> pointDeltas(endPointId - pointId, 0.0);
+    ImageDataUtils::ForEachTile(ImageDataUtils::Grid { *output }, [&mergedArrays](ImageDataUtils::Tile const& tile) {
+        for (auto const& [mergedOutput, branches] : mergedArrays) {
+            for (vtkIdType id = tile.GetPointIdBegin(); id < tile.GetPointIdEnd(); id++) {
+                float const baseValue = mergedOutput.Values ? mergedOutput.Values[id] : 0.0F;
 
-            for (auto const*const inArray: inArrays) {
-                pointId = startPointId;
+                float pointDelta = 0.0F;
+                for (auto const* const branch : branches)
+                    pointDelta += branch[id] - baseValue;
 
-                for (int j = 0; pointId < endPointId; pointId++, j++)
-                    pointDeltas[j] += inArray[pointId] - outArray[pointId];
+                mergedOutput.WritableValues[id] = baseValue + pointDelta;
             }
-            pointId = startPointId;
-
-            for (int j = 0; pointId < endPointId; pointId++, j++)
-                outArray[pointId] += pointDeltas[j];
-
-            pointId = startPointId;
         }
-    };
-    vtkSMPTools::For(0, numberOfPoints, addInputArrayDeltasToOutputArrays);
-
+    });
 
     SetErrorCode(vtkErrorCode::NoError);
 
@@ -171,7 +157,6 @@ auto MergeParallelImageArtifactFilters::GetContainedSubTypes(vtkInformation* bas
         if (PointDataInformationVectorHasArray(baseInInfo, enumValue)
             || InfoPointDataInformationVectorHasArray(parallelInInfos, enumValue)) {
             containedSubTypes.push_back(enumValue);
-            break;
         }
     }
     return containedSubTypes;
@@ -0,0 +1,101 @@
+#include "PointwiseImageArtifactFilter.h"
+
+#include <vtkImageData.h>
+
+#include <algorithm>
+
+auto PointwiseImageArtifactFilter::RequestInformation(vtkInformation* request,
+                                                      vtkInformationVector** inputVector,
+                                                      vtkInformationVector* outputVector) -> int {
+    ImageArtifactFilter::RequestInformation(request, inputVector, outputVector);
+
+    if (OutputArtifactArrays)
+        AddArrayInformationToPointDataVector(GetSubType(), outputVector);
+
+    return 1;
+}
+
+void PointwiseImageArtifactFilter::ExecuteDataWithImageInformation(vtkImageData* input,
+                                                                   vtkImageData* output,
+                                                                   vtkInformation* outInfo) {
+    std::array<PointwiseImageArtifactFilter*, 1> const filters { this };
+    ExecuteKernels(*this, *output, filters);
+}
+
+auto PointwiseImageArtifactFilter::ExecuteKernels(ImageArtifactFilter& self, vtkImageData& output,
+                                                  std::span<PointwiseImageArtifactFilter* const> filters) -> void {
+    std::vector<std::unique_ptr<Kernel>> kernels;
+    std::ranges::transform(filters, std::back_inserter(kernels),
+                           [&output](PointwiseImageArtifactFilter* filter) { return filter->CreateKernel(output); });
+
+    // kernels of the same sub type add to the same artifact array
+    std::vector<SubType> subTypes;
+    std::vector<size_t> kernelArrayIdxs;
+    if (self.GetOutputArtifactArrays()) {
+        for (auto const* filter : filters) {
+            SubType const subType = filter->GetSubType();
+            auto const subTypeIt = std::ranges::find(subTypes, subType);
+            kernelArrayIdxs.push_back(std::distance(subTypes.begin(), subTypeIt));
+            if (subTypeIt == subTypes.end())
+                subTypes.push_back(subType);
+        }
+    }
+
+    CopyOnWriteArray radiodensityArray = GetRadiodensities(&output);
+    CopyOnWriteArray::OverwritePass const radiodensities = radiodensityArray.Overwrite();
+
+    std::vector<CopyOnWriteArray> artifactArrays;
+    std::ranges::transform(subTypes, std::back_inserter(artifactArrays),
+                           [&output](SubType subType) { return GetArtifactValues(&output, subType); });
+    std::vector<CopyOnWriteArray::OverwritePass> artifactValues;
+    std::ranges::transform(artifactArrays, std::back_inserter(artifactValues),
+                           [](CopyOnWriteArray& array) { return array.Overwrite(); });
+
+    ImageDataUtils::Grid const grid { output };
+    auto const rowLength = static_cast<size_t>(grid.Dimensions[0]);
+
+    ImageDataUtils::ForEachTile(grid, [&](ImageDataUtils::Tile const& tile) {
+        self.CheckAbort();
+
+        if (self.GetAbortOutput())
+            return;
+
+        std::vector<float> rowRadiodensities(rowLength);
+        std::vector<float> rowArtifactValues(rowLength);
+
+        tile.ForEachRow([&](ImageDataUtils::Row const& row) {
+            vtkIdType const rowPointId = row.PointId;
+
+            auto copyRow = [rowPointId, rowLength](float const* values, float* target) {
+                if (!values) {
+                    std::fill_n(target, rowLength, 0.0F);
+                    return;
+                }
+
+                if (float const* const rowValues = std::next(values, rowPointId); rowValues != target)
+                    std::copy_n(rowValues, rowLength, target);
+            };
+
+            copyRow(radiodensities.Values, rowRadiodensities.data());
+            for (auto const& pass : artifactValues)
+                copyRow(pass.Values, std::next(pass.WritableValues, rowPointId));
+
+            for (size_t k = 0; k < kernels.size(); k++) {
+                kernels[k]->EvaluateRow(row, rowRadiodensities, rowArtifactValues);
+
+                for (size_t x = 0; x < rowLength; x++)
+                    rowRadiodensities[x] += rowArtifactValues[x];
+
+                if (artifactValues.empty())
+                    continue;
+
+                float* const rowArtifactArrayValues = std::next(artifactValues[kernelArrayIdxs[k]].WritableValues,
+                                                                rowPointId);
+                for (size_t x = 0; x < rowLength; x++)
+                    rowArtifactArrayValues[x] += rowArtifactValues[x];
+            }
+
+            std::ranges::copy(rowRadiodensities, std::next(radiodensities.WritableValues, rowPointId));
+        });
+    });
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ImageArtifactFilter.h"
+#include "../../../Utils/ImageDataUtils.h"
+
+#include <memory>
+#include <span>
+
+/**
+ * Image artifact filter whose artifact value at a voxel only depends on the voxel's position and radiodensity.
+ * The artifact is evaluated row by row by a kernel, so that the artifacts of consecutive pointwise filters can be
+ * applied in a single pass over the volume (see FusedImageArtifactFilter).
+ */
+class PointwiseImageArtifactFilter : public ImageArtifactFilter {
+public:
+    vtkAbstractTypeMacro(PointwiseImageArtifactFilter, ImageArtifactFilter)
+
+    /** Evaluates the artifact of a filter on the rows of a volume */
+    struct Kernel {
+        ImageDataUtils::Grid VoxelGrid;
+
+        explicit Kernel(vtkImageData& volume) : VoxelGrid(volume) {}
+        virtual ~Kernel() = default;
+
+        /** Writes the artifact values of the voxels of the row given their current radiodensities */
+        virtual auto
+        EvaluateRow(ImageDataUtils::Row const& row,
+                    std::span<float const> radiodensities, std::span<float> artifactValues) const -> void = 0;
+    };
+
+    [[nodiscard]] virtual auto
+    GetSubType() const noexcept -> SubType = 0;
+
+    /** Creates the kernel evaluating the artifact with the current parameters of the filter on the given volume */
+    [[nodiscard]] virtual auto
+    CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> = 0;
+
+    /**
+     * Applies the artifacts of the given filters one after another to the output in a single pass.
+     * Each filter's artifact is evaluated on the radiodensities including the artifacts of the preceding filters.
+     * The artifact arrays are only written if self outputs them.
+     */
+    auto static
+    ExecuteKernels(ImageArtifactFilter& self, vtkImageData& output,
+                   std::span<PointwiseImageArtifactFilter* const> filters) -> void;
+
+protected:
+    PointwiseImageArtifactFilter() = default;
+    ~PointwiseImageArtifactFilter() override = default;
+
+    auto RequestInformation(vtkInformation* request,
+                            vtkInformationVector** inputVector,
+                            vtkInformationVector* outputVector) -> int override;
+
+    auto
+    ExecuteDataWithImageInformation(vtkImageData* input, vtkImageData* output, vtkInformation* outInfo) -> void override;
+};
@@ -1,14 +1,15 @@
 #pragma once
 
-#include "ImageArtifactFilter.h"
+#include "PointwiseImageArtifactFilter.h"
+#include "SliceCoordinateTable.h"
 
-class RingArtifactFilter : public ImageArtifactFilter {
+class RingArtifactFilter : public PointwiseImageArtifactFilter {
 public:
     RingArtifactFilter(const RingArtifactFilter&) = delete;
     void operator=(const RingArtifactFilter&) = delete;
 
     static RingArtifactFilter* New();
-    vtkTypeMacro(RingArtifactFilter, ImageArtifactFilter);
+    vtkTypeMacro(RingArtifactFilter, PointwiseImageArtifactFilter);
     void PrintSelf(ostream& os, vtkIndent indent) override;
 
     vtkSetClampMacro(InnerRadius, float, 0.0, 100.0);
@@ -31,37 +32,27 @@ public:
     [[nodiscard]] auto
     GetCenterPoint() const -> std::array<float, 3> { return Center; }
 
+    [[nodiscard]] auto
+    GetSubType() const noexcept -> SubType override { return SubType::RING; }
+
+    [[nodiscard]] auto
+    CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> override;
+
 protected:
     RingArtifactFilter() = default;
     ~RingArtifactFilter() override = default;
 
-    int RequestInformation(vtkInformation *request,
-                           vtkInformationVector **inputVector,
-                           vtkInformationVector *outputVector) override;
-
-    auto
-    ExecuteDataWithImageInformation(vtkImageData* input, vtkImageData* output, vtkInformation* outInfo) -> void override;
-
-    struct Algorithm {
-        RingArtifactFilter* Self;
-        vtkImageData* VolumeData;
-        std::array<double, 3> Spacing;
-        std::array<int, 3> UpdateDims;
-        DoublePoint StartPoint;
-        float const* Radiodensities;
-        float* ArtifactValues;
+    struct Algorithm : Kernel {
         float InnerRadius;
-        float RingWidth;
         float OuterRadius;
         float RadiodensityChangeFactor;
-        FloatPoint Center;
+        std::shared_ptr<SliceCoordinateTable const> Radii;
 
-        Algorithm(RingArtifactFilter* self,
-                  vtkImageData* volumeData,
-                  float const* radiodensities,
-                  float* artifactValues);
+        Algorithm(RingArtifactFilter* self, vtkImageData& volume);
 
-        void operator()(vtkIdType pointId, vtkIdType endPointId) const;
+        auto
+        EvaluateRow(ImageDataUtils::Row const& row,
+                    std::span<float const> radiodensities, std::span<float> artifactValues) const -> void override;
     };
 
     float InnerRadius = 0.0F;
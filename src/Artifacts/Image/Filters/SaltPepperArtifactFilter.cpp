@@ -1,13 +1,7 @@
 #include "SaltPepperArtifactFilter.h"
 
-#include <vtkFloatArray.h>
 #include <vtkImageData.h>
-#include <vtkInformation.h>
 #include <vtkObjectFactory.h>
-#include <vtkPointData.h>
-#include <vtkSMPTools.h>
-
-#include <random>
 
 vtkStandardNewMacro(SaltPepperArtifactFilter)
 
@@ -19,98 +13,33 @@ void SaltPepperArtifactFilter::PrintSelf(ostream &os, vtkIndent indent) {
 
     os << indent << "Salt Intensity Value: " << SaltIntensityValue << ")\n";
     os << indent << "Pepper Intensity Value: " << PepperIntensityValue << ")\n";
+    os << indent << "Seed: " << Seed << ", Stream: " << StreamId << "\n";
 }
 
-auto SaltPepperArtifactFilter::RequestInformation(vtkInformation* request,
-                                                 vtkInformationVector** inputVector,
-                                                 vtkInformationVector *outputVector) -> int {
-    ImageArtifactFilter::RequestInformation(request, inputVector, outputVector);
-
-    AddArrayInformationToPointDataVector(SubType::SALT_PEPPER, outputVector);
-
-    return 1;
+auto SaltPepperArtifactFilter::CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> {
+    return std::make_unique<Algorithm>(this, volume);
 }
 
-struct FillWithRandomIndices {
-    std::vector<vtkIdType>& Indices;
-    int NumberOfIndices;
-    vtkIdType NumberOfPoints;
-
-    auto operator() () const noexcept -> void {
-        static unsigned int seed = 0;
-
-        std::uniform_int_distribution<vtkIdType> uniformDistribution { 0, NumberOfPoints - 1 };
-        std::minstd_rand engine { ++seed };
-
-        Indices.resize(NumberOfIndices, std::numeric_limits<vtkIdType>::max());
-
-        for (auto IdxsEndIt = Indices.begin(); IdxsEndIt != Indices.end();) {
-            std::generate(IdxsEndIt, Indices.end(),
-                          [&] { return uniformDistribution(engine); });
-            std::ranges::sort(Indices);
-            IdxsEndIt = std::ranges::unique(Indices).begin();
-        }
-    }
-};
-
-struct AddNoise {
-    std::vector<vtkIdType> const& Indices;
-    float const* Radiodensities;
-    float* SaltPepperNoiseValues;
-    float NoiseValue;
-
-    void operator()(vtkIdType indicesIdx, vtkIdType endIndicesIdx) const {
-
-        for (; indicesIdx < endIndicesIdx; indicesIdx++)
-            SaltPepperNoiseValues[Indices[indicesIdx]] = NoiseValue - Radiodensities[Indices[indicesIdx]];
+SaltPepperArtifactFilter::Algorithm::Algorithm(SaltPepperArtifactFilter* self, vtkImageData& volume) :
+        Kernel(volume),
+        RandomStream(self->GetSeed(), self->GetStreamId()),
+        SaltAmount(self->GetSaltAmount()),
+        PepperAmount(self->GetPepperAmount()),
+        SaltIntensityValue(self->GetSaltIntensityValue()),
+        PepperIntensityValue(self->GetPepperIntensityValue()) {}
+
+auto SaltPepperArtifactFilter::Algorithm::EvaluateRow(ImageDataUtils::Row const& row,
+                                                      std::span<float const> radiodensities,
+                                                      std::span<float> artifactValues) const -> void {
+    // every voxel independently becomes pepper or else salt with the given probabilities
+    for (size_t x = 0; x < artifactValues.size(); x++) {
+        std::array<float, 4> const random = RandomStream.Uniform(row.PointId + x);
+
+        if (random[0] < PepperAmount)
+            artifactValues[x] = PepperIntensityValue - radiodensities[x];
+        else if (random[1] < SaltAmount)
+            artifactValues[x] = SaltIntensityValue - radiodensities[x];
+        else
+            artifactValues[x] = 0.0F;
     }
-};
-
-void SaltPepperArtifactFilter::ExecuteDataWithImageInformation(vtkImageData* input,
-                                                               vtkImageData* output,
-                                                               vtkInformation* outInfo) {
-    vtkIdType const numberOfPoints = output->GetNumberOfPoints();
-
-    int const numberOfSaltIndices = vtkMath::Ceil(numberOfPoints * SaltAmount);
-    std::vector<vtkIdType> saltIndices;
-
-    int const numberOfPepperIndices = vtkMath::Ceil(numberOfPoints * PepperAmount);
-    std::vector<vtkIdType> pepperIndices;
-
-    std::thread saltIndicesThread   (FillWithRandomIndices{ saltIndices,   numberOfSaltIndices,   numberOfPoints });
-    std::thread pepperIndicesThread (FillWithRandomIndices{ pepperIndices, numberOfPepperIndices, numberOfPoints });
-    saltIndicesThread.join();
-    pepperIndicesThread.join();
-
-    vtkNew<vtkFloatArray> const newNoiseValueArray;
-    newNoiseValueArray->SetNumberOfComponents(1);
-    newNoiseValueArray->SetNumberOfTuples(numberOfPoints);
-    newNoiseValueArray->FillValue(0.0F);
-    float* newNoiseValues = newNoiseValueArray->WritePointer(0, numberOfPoints);
-
-    vtkFloatArray* radioDensityArray = GetRadiodensitiesArray(output);
-    float* radiodensities = radioDensityArray->WritePointer(0, numberOfPoints);
-
-    vtkSMPTools::For(0, numberOfSaltIndices,   AddNoise { saltIndices,   radiodensities,
-                                                          newNoiseValues, SaltIntensityValue });
-    vtkSMPTools::For(0, numberOfPepperIndices, AddNoise { pepperIndices, radiodensities,
-                                                          newNoiseValues, PepperIntensityValue });
-
-
-    vtkFloatArray* saltPepperNoiseArray = GetDeepCopiedArtifactArray(input, output, SubType::SALT_PEPPER);
-    float* saltPepperNoiseValues = saltPepperNoiseArray->WritePointer(0, numberOfPoints);
-
-    auto addNoiseValues = [noiseValues = saltPepperNoiseValues,
-                           newNoiseValues = newNoiseValues,
-                           radiodensities = radiodensities] (vtkIdType pointId, vtkIdType endPointId) {
-        vtkIdType const startPointId = pointId;
-
-        for (; pointId < endPointId; pointId++)
-            radiodensities[pointId] += newNoiseValues[pointId];
-
-        pointId = startPointId;
-        for (; pointId < endPointId; pointId++)
-            noiseValues[pointId] += newNoiseValues[pointId];
-    };
-    vtkSMPTools::For(0, numberOfPoints, addNoiseValues);
 }
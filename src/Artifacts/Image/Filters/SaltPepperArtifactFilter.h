@@ -1,14 +1,15 @@
 #pragma once
 
-#include "ImageArtifactFilter.h"
+#include "PointwiseImageArtifactFilter.h"
+#include "../../../Utils/CounterBasedRandom.h"
 
-class SaltPepperArtifactFilter : public ImageArtifactFilter {
+class SaltPepperArtifactFilter : public PointwiseImageArtifactFilter {
 public:
     SaltPepperArtifactFilter(const SaltPepperArtifactFilter&) = delete;
     void operator=(const SaltPepperArtifactFilter&) = delete;
 
     static SaltPepperArtifactFilter* New();
-    vtkTypeMacro(SaltPepperArtifactFilter, ImageArtifactFilter);
+    vtkTypeMacro(SaltPepperArtifactFilter, PointwiseImageArtifactFilter);
     void PrintSelf(ostream& os, vtkIndent indent) override;
 
     vtkSetClampMacro(SaltAmount, float, 0.0, 1.0);
@@ -23,21 +24,43 @@ public:
     vtkSetClampMacro(PepperIntensityValue, float, -1000.0, 0.0);
     vtkGetMacro(PepperIntensityValue, float);
 
+    /** The noise is a function of the seed, the stream and the voxel index */
+    vtkSetMacro(Seed, vtkTypeUInt64);
+    vtkGetMacro(Seed, vtkTypeUInt64);
+
+    vtkSetMacro(StreamId, vtkTypeUInt32);
+    vtkGetMacro(StreamId, vtkTypeUInt32);
+
+    [[nodiscard]] auto
+    GetSubType() const noexcept -> SubType override { return SubType::SALT_PEPPER; }
+
+    [[nodiscard]] auto
+    CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> override;
 
 protected:
     SaltPepperArtifactFilter() = default;
     ~SaltPepperArtifactFilter() override = default;
 
-    int RequestInformation(vtkInformation *request,
-                           vtkInformationVector **inputVector,
-                           vtkInformationVector *outputVector) override;
+    struct Algorithm : Kernel {
+        CounterBasedRandom::Stream RandomStream;
+        float SaltAmount;
+        float PepperAmount;
+        float SaltIntensityValue;
+        float PepperIntensityValue;
 
-    auto
-    ExecuteDataWithImageInformation(vtkImageData* input, vtkImageData* output, vtkInformation* outInfo) -> void override;
+        Algorithm(SaltPepperArtifactFilter* self, vtkImageData& volume);
+
+        auto
+        EvaluateRow(ImageDataUtils::Row const& row,
+                    std::span<float const> radiodensities, std::span<float> artifactValues) const -> void override;
+    };
 
     float SaltAmount;
     float PepperAmount;
 
     float SaltIntensityValue;
     float PepperIntensityValue;
+
+    vtkTypeUInt64 Seed = 0;
+    vtkTypeUInt32 StreamId = 0;
 };
@@ -0,0 +1,76 @@
+#include "SliceCoordinateTable.h"
+
+#include <vtkImageData.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <numbers>
+
+SliceCoordinateTable::SliceCoordinateTable(Key const& key) :
+        RowLength(key.Dimensions[0]),
+        Values(static_cast<std::size_t>(key.Dimensions[0]) * key.Dimensions[1]) {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(key.Dimensions[1]), [this, &key](vtkIdType y, vtkIdType endY) {
+        for (; y < endY; y++) {
+            double const yDistance = key.StartPoint[1] + y * key.Spacing[1] - key.Center[1];
+            float* const row = std::next(Values.data(), y * static_cast<vtkIdType>(RowLength));
+
+            for (int x = 0; x < key.Dimensions[0]; x++) {
+                double const xDistance = key.StartPoint[0] + x * key.Spacing[0] - key.Center[0];
+
+                row[x] = key.Type == Coordinate::RADIUS
+                        ? static_cast<float>(std::sqrt(xDistance * xDistance + yDistance * yDistance))
+                        : static_cast<float>(std::atan2(yDistance, xDistance) + std::numbers::pi);
+            }
+        }
+    });
+}
+
+auto SliceCoordinateTable::Get(vtkImageData& volume, std::array<float, 3> const& center,
+                               Coordinate coordinate) -> std::shared_ptr<SliceCoordinateTable const> {
+    std::array<double, 3> startPoint {};
+    volume.GetPoint(0, startPoint.data());
+    int const* dimensions = volume.GetDimensions();
+    double const* spacing = volume.GetSpacing();
+
+    Key const key { { dimensions[0], dimensions[1] },
+                    { spacing[0], spacing[1] },
+                    { startPoint[0], startPoint[1] },
+                    { center[0], center[1] },
+                    coordinate };
+
+    static std::mutex mutex;
+    static std::list<std::pair<Key, std::shared_ptr<SliceCoordinateTable const>>> entries; // most recently used first
+
+    auto const findEntry = [&key] {
+        return std::ranges::find(entries, key, [](auto const& entry) { return entry.first; });
+    };
+
+    {
+        std::scoped_lock const lock { mutex };
+
+        if (auto const it = findEntry(); it != entries.end()) {
+            entries.splice(entries.begin(), entries, it);
+            return it->second;
+        }
+    }
+
+    // built without holding the lock, so lookups of other tables are not blocked meanwhile
+    auto table = std::make_shared<SliceCoordinateTable const>(key);
+
+    std::scoped_lock const lock { mutex };
+
+    // a table built concurrently for the same key wins, so that all callers share one
+    if (auto const it = findEntry(); it != entries.end()) {
+        entries.splice(entries.begin(), entries, it);
+        return it->second;
+    }
+
+    entries.emplace_front(key, std::move(table));
+    if (entries.size() > MaxNumberOfCachedTables)
+        entries.pop_back();
+
+    return entries.front().second;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vtkType.h>
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <vector>
+
+class vtkImageData;
+
+
+/**
+ * Polar coordinates of the voxels of an xy slice relative to a center, x fastest.
+ * The coordinates are the same for every slice of a volume, so radial and angular artifacts look them up
+ * instead of evaluating sqrt / atan2 per voxel.
+ * Tables are shared by all filters (and parameter space states) with the same slice geometry and center
+ * through a small process-wide cache of the most recently used tables.
+ */
+class SliceCoordinateTable {
+public:
+    enum struct Coordinate : uint8_t {
+        RADIUS, // distance to the center
+        ANGLE   // angle around the center in [0, 2 pi]
+    };
+
+    struct Key {
+        std::array<int, 2> Dimensions;
+        std::array<double, 2> Spacing;
+        std::array<double, 2> StartPoint;
+        std::array<float, 2> Center;
+        Coordinate Type;
+
+        [[nodiscard]] auto
+        operator==(Key const&) const noexcept -> bool = default;
+    };
+
+    explicit SliceCoordinateTable(Key const& key);
+
+    /** The (cached) table of the given coordinate for the slices of the volume */
+    [[nodiscard]] auto static
+    Get(vtkImageData& volume, std::array<float, 3> const& center,
+        Coordinate coordinate) -> std::shared_ptr<SliceCoordinateTable const>;
+
+    [[nodiscard]] auto
+    GetRow(int y) const noexcept -> std::span<float const> {
+        return { std::next(Values.data(), static_cast<vtkIdType>(y) * RowLength), RowLength };
+    }
+
+    static constexpr std::size_t MaxNumberOfCachedTables = 16;
+
+private:
+    std::size_t RowLength;
+    std::vector<float> Values;
+};
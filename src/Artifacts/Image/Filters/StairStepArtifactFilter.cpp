@@ -1,14 +1,14 @@
 #include "StairStepArtifactFilter.h"
-#include "../../../Modeling/CtDataSource.h"
 
-#include <vtkFloatArray.h>
+#include "../../../Utils/ImageDataUtils.h"
+
 #include <vtkImageData.h>
 #include <vtkInformation.h>
 #include <vtkObjectFactory.h>
-#include <vtkPointData.h>
-#include <vtkSMPTools.h>
 
-#include <numbers>
+#include <algorithm>
+#include <cmath>
+#include <optional>
 
 vtkStandardNewMacro(StairStepArtifactFilter)
 
@@ -23,7 +23,8 @@ auto StairStepArtifactFilter::RequestInformation(vtkInformation* request,
                                                 vtkInformationVector *outputVector) -> int {
     ImageArtifactFilter::RequestInformation(request, inputVector, outputVector);
 
-    AddArrayInformationToPointDataVector(SubType::STAIR_STEP, outputVector);
+    if (OutputArtifactArrays)
+        AddArrayInformationToPointDataVector(SubType::STAIR_STEP, outputVector);
 
     return 1;
 }
@@ -31,72 +32,87 @@ auto StairStepArtifactFilter::RequestInformation(vtkInformation* request,
 void StairStepArtifactFilter::ExecuteDataWithImageInformation(vtkImageData* input,
                                                               vtkImageData* output,
                                                               vtkInformation* outInfo) {
-    vtkIdType const numberOfPoints = output->GetNumberOfPoints();
-
-    vtkNew<vtkFloatArray> const newArtifactValueArray;
-    newArtifactValueArray->SetNumberOfComponents(1);
-    newArtifactValueArray->SetNumberOfTuples(numberOfPoints);
-    newArtifactValueArray->FillValue(0.0F);
-    float* newArtifactValues = newArtifactValueArray->WritePointer(0, numberOfPoints);
-
-    vtkFloatArray* radioDensityArray = GetRadiodensitiesArray(output);
-    float* radiodensities = radioDensityArray->WritePointer(0, numberOfPoints);
-
     std::array<double, 6> bounds {};
     output->GetBounds(bounds.data());
     double const zDistance = bounds[5] - bounds[4];
 
-    std::array<int, 6> previousExtent {}, newExtent {};
-    output->GetExtent(previousExtent.data());
-    newExtent = previousExtent;
-    int const zPreviousNrOfVoxels = previousExtent[5] - previousExtent[4];
+    std::array<int, 6> extent {};
+    output->GetExtent(extent.data());
+    int const zPreviousNrOfVoxels = extent[5] - extent[4];
     int const zNewNrOfVoxels = std::max(static_cast<int>(zPreviousNrOfVoxels * SamplingRate), 2);
-    newExtent[5] = zNewNrOfVoxels;
-
-    std::array<double, 3> previousOutputSpacing {}, newOutputSpacing {};
-    output->GetSpacing(previousOutputSpacing.data());
-    newOutputSpacing = previousOutputSpacing;
-    newOutputSpacing[2] = zDistance / static_cast<double>(zNewNrOfVoxels);
-
-    vtkNew<vtkImageReslice> const imageDownSample;
-    imageDownSample->SetOutputSpacing(newOutputSpacing.data());
-    imageDownSample->SetOutputExtent(newExtent.data());
-    imageDownSample->SetInputData(input);
-    imageDownSample->Update();
-    vtkSmartPointer const downSampledImage = imageDownSample->GetOutput();
 
-    vtkNew<vtkImageReslice> const imageUpSample;
-    imageUpSample->SetOutputSpacing(previousOutputSpacing.data());
-    imageUpSample->SetOutputExtent(previousExtent.data());
-    imageUpSample->SetInputData(downSampledImage);
-    imageUpSample->Update();
-    vtkSmartPointer const upSampledImage = imageUpSample->GetOutput();
-
-    assert(output->GetNumberOfPoints() == upSampledImage->GetNumberOfPoints());
-
-    vtkFloatArray* resampledRadiodensityArray = vtkFloatArray::SafeDownCast(upSampledImage->GetPointData()->GetScalars());
-    float* resampledRadiodensities = resampledRadiodensityArray->WritePointer(0, numberOfPoints);
-
-    auto calculateSamplingArtifactValues = [newArtifactValues, resampledRadiodensities, radiodensities] (vtkIdType pointId, vtkIdType endPointId) {
-        for (; pointId < endPointId; pointId++)
-            newArtifactValues[pointId] = resampledRadiodensities[pointId] - radiodensities[pointId];
-    };
-
-    vtkSMPTools::For(0, numberOfPoints, calculateSamplingArtifactValues);
+    std::array<double, 3> spacing {};
+    output->GetSpacing(spacing.data());
+    double const newZSpacing = zDistance / static_cast<double>(zNewNrOfVoxels);
+
+    std::vector<int> const sourceSlices = GetSourceSlices({ extent[4], extent[5] }, zNewNrOfVoxels,
+                                                          spacing[2], newZSpacing);
+
+    ImageDataUtils::Grid const grid { *output };
+    vtkIdType const sliceSize = grid.GetSliceSize();
+
+    CopyOnWriteArray radiodensityArray = GetRadiodensities(output);
+    CopyOnWriteArray::OverwritePass const radiodensities = radiodensityArray.Overwrite();
+
+    std::optional<CopyOnWriteArray> artifactArray;
+    CopyOnWriteArray::OverwritePass artifactValues {};
+    if (OutputArtifactArrays) {
+        artifactArray.emplace(GetArtifactValues(output, SubType::STAIR_STEP));
+        artifactValues = artifactArray->Overwrite();
+    }
+
+    // the output row (y, z) is row (y, sourceSlices[z]) of the input, so the artifact is computed in a single pass
+    ImageDataUtils::ForEachTile(grid, [&](ImageDataUtils::Tile const& tile) {
+        CheckAbort();
+
+        if (GetAbortOutput())
+            return;
+
+        tile.ForEachRow([&](ImageDataUtils::Row const& row) {
+            int const z = row.Z;
+            vtkIdType const rowPointId = row.PointId;
+            int const sourceSlice = sourceSlices[z];
+
+            float const* const rowRadiodensities = std::next(radiodensities.Values, rowPointId);
+            float const* const sourceRadiodensities = sourceSlice == -1
+                    ? nullptr
+                    : std::next(radiodensities.Values, rowPointId + (sourceSlice - z) * sliceSize);
+            float const* const rowArtifactValues = artifactValues.Values
+                    ? std::next(artifactValues.Values, rowPointId)
+                    : nullptr;
+            float* const newRadiodensities = std::next(radiodensities.WritableValues, rowPointId);
+            float* const newArtifactValues = artifactValues.WritableValues
+                    ? std::next(artifactValues.WritableValues, rowPointId)
+                    : nullptr;
+
+            for (int x = 0; x < grid.Dimensions[0]; x++) {
+                float const resampledRadiodensity = sourceRadiodensities ? sourceRadiodensities[x] : 0.0F;
+                float const artifactValue = resampledRadiodensity - rowRadiodensities[x];
+
+                newRadiodensities[x] = rowRadiodensities[x] + artifactValue;
+                if (newArtifactValues)
+                    newArtifactValues[x] = (rowArtifactValues ? rowArtifactValues[x] : 0.0F) + artifactValue;
+            }
+        });
+    });
+}
 
+auto StairStepArtifactFilter::GetSourceSlices(std::array<int, 2> zExtent, int sampledZMax,
+                                              double zSpacing, double sampledZSpacing) -> std::vector<int> {
+    // nearest neighbor rounding as in vtkImageReslice
+    auto const round = [](double value) { return static_cast<int>(std::floor(value + 0.5)); };
 
-    vtkFloatArray* stairStepArtifactArray = GetDeepCopiedArtifactArray(input, output, SubType::STAIR_STEP);
-    float* stairStepArtifactValues = stairStepArtifactArray->WritePointer(0, numberOfPoints);
+    std::vector<int> sourceSlices;
+    sourceSlices.reserve(zExtent[1] - zExtent[0] + 1);
 
-    auto addArtifactValues = [stairStepArtifactValues, newArtifactValues, radiodensities] (vtkIdType pointId, vtkIdType endPointId) {
-        vtkIdType const startPointId = pointId;
+    for (int z = zExtent[0]; z <= zExtent[1]; z++) {
+        int const sampledZ = round(z * zSpacing / sampledZSpacing);
+        int const sourceZ = round(sampledZ * sampledZSpacing / zSpacing);
 
-        for (; pointId < endPointId; pointId++)
-            radiodensities[pointId] += newArtifactValues[pointId];
+        bool const isInside = sampledZ >= zExtent[0] && sampledZ <= sampledZMax
+                                      && sourceZ >= zExtent[0] && sourceZ <= zExtent[1];
+        sourceSlices.push_back(isInside ? sourceZ - zExtent[0] : -1);
+    }
 
-        pointId = startPointId;
-        for (; pointId < endPointId; pointId++)
-            stairStepArtifactValues[pointId] += newArtifactValues[pointId];
-    };
-    vtkSMPTools::For(0, numberOfPoints, addArtifactValues);
+    return sourceSlices;
 }
@@ -2,7 +2,7 @@
 
 #include "ImageArtifactFilter.h"
 
-#include <vtkImageResample.h>
+#include <vector>
 
 class StairStepArtifactFilter : public ImageArtifactFilter {
 public:
@@ -27,5 +27,13 @@ protected:
     auto
     ExecuteDataWithImageInformation(vtkImageData* input, vtkImageData* output, vtkInformation* outInfo) -> void override;
 
+    /**
+     * Input slice each output slice takes its values from when the volume is downsampled along z to the given
+     * spacing and upsampled back with nearest neighbor interpolation, or -1 if the slice samples the background
+     */
+    [[nodiscard]] auto static
+    GetSourceSlices(std::array<int, 2> zExtent, int sampledZMax, double zSpacing, double sampledZSpacing)
+            -> std::vector<int>;
+
     float SamplingRate = 0.0F;
 };
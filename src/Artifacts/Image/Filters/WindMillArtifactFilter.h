@@ -1,14 +1,15 @@
 #pragma once
 
-#include "ImageArtifactFilter.h"
+#include "PointwiseImageArtifactFilter.h"
+#include "SliceCoordinateTable.h"
 
-class WindMillArtifactFilter : public ImageArtifactFilter {
+class WindMillArtifactFilter : public PointwiseImageArtifactFilter {
 public:
     WindMillArtifactFilter(const WindMillArtifactFilter&) = delete;
     void operator=(const WindMillArtifactFilter&) = delete;
 
     static WindMillArtifactFilter* New();
-    vtkTypeMacro(WindMillArtifactFilter, ImageArtifactFilter);
+    vtkTypeMacro(WindMillArtifactFilter, PointwiseImageArtifactFilter);
     void PrintSelf(ostream& os, vtkIndent indent) override;
 
     vtkSetClampMacro(BrightAngularWidth, float, 0.0, 360.0);
@@ -29,37 +30,30 @@ public:
     [[nodiscard]] auto
     GetCenterPoint() const -> std::array<float, 3> { return Center; }
 
+    [[nodiscard]] auto
+    GetSubType() const noexcept -> SubType override { return SubType::WIND_MILL; }
+
+    [[nodiscard]] auto
+    CreateKernel(vtkImageData& volume) -> std::unique_ptr<Kernel> override;
+
 protected:
     WindMillArtifactFilter() = default;
     ~WindMillArtifactFilter() override = default;
 
-    int RequestInformation(vtkInformation *request,
-                           vtkInformationVector **inputVector,
-                           vtkInformationVector *outputVector) override;
-
-    auto
-    ExecuteDataWithImageInformation(vtkImageData* input,
-                                    vtkImageData* output,
-                                    vtkInformation* outInfo) -> void override;
-
-    struct Algorithm {
-        WindMillArtifactFilter* Self;
-        vtkImageData* VolumeData;
-        std::array<double, 3> Spacing;
-        std::array<int, 3> UpdateDims;
-        DoublePoint StartPoint;
-        float* ArtifactValues;
+    struct Algorithm : Kernel {
         float BrightAngularWidth;
         float DarkAngularWidth;
         float CombinedAngularWidth;
         float BrightDarkThreshold;
         float BrightIntensityValue;
         float DarkIntensityValue;
-        FloatPoint Center;
+        std::shared_ptr<SliceCoordinateTable const> Angles;
 
-        Algorithm(WindMillArtifactFilter* self, vtkImageData* volumeData, float* artifactValues);
+        Algorithm(WindMillArtifactFilter* self, vtkImageData& volume);
 
-        void operator()(vtkIdType pointId, vtkIdType endPointId) const;
+        auto
+        EvaluateRow(ImageDataUtils::Row const& row,
+                    std::span<float const> radiodensities, std::span<float> artifactValues) const -> void override;
     };
 
     float BrightAngularWidth = 0.0F;
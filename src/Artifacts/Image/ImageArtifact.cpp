@@ -100,6 +100,18 @@ auto ImageArtifact::AppendImageFilters(vtkImageAlgorithm& inputAlgorithm) -> vtk
                       Artifact);
 }
 
+auto ImageArtifact::GetPointwiseFilter() -> PointwiseImageArtifactFilter* {
+    return std::visit(Overload {
+            [](BasicImageArtifact& basic) { return basic.GetPointwiseFilter(); },
+            [](CompositeImageArtifact&) -> PointwiseImageArtifactFilter* { return nullptr; }
+    }, Artifact);
+}
+
+auto ImageArtifact::SetNoiseSeed(uint64_t seed, uint32_t streamId) const -> void {
+    if (auto const* basic = std::get_if<BasicImageArtifact>(&Artifact))
+        basic->SetNoiseSeed(seed, streamId);
+}
+
 ImageArtifactData::ImageArtifactData(const ImageArtifact& artifact) :
         Data([&] {
             return std::visit(Overload {
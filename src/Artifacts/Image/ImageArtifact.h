@@ -51,6 +51,12 @@ public:
     auto
     AppendImageFilters(vtkImageAlgorithm& inputAlgorithm) -> vtkImageAlgorithm&;
 
+    [[nodiscard]] auto
+    GetPointwiseFilter() -> PointwiseImageArtifactFilter*;
+
+    auto
+    SetNoiseSeed(uint64_t seed, uint32_t streamId) const -> void;
+
 private:
     friend struct ImageArtifactData;
 
@@ -1,5 +1,6 @@
 #include "ImageArtifactConcatenation.h"
 
+#include <unordered_set>
 #include <utility>
 
 #include "ImageArtifact.h"
@@ -73,12 +74,54 @@ auto ImageArtifactConcatenation::GetEndFilter() const -> vtkImageAlgorithm& {
 auto ImageArtifactConcatenation::UpdateArtifactFilter() const -> void {
     auto& secondToLastFilter = Start->AppendImageFilters(*StartFilter);
     EndFilter->SetInputConnection(secondToLastFilter.GetOutputPort());
+
+    // composite artifacts may create new (fused, merge) filters when appending theirs, so all filters between the
+    // start and end filter are visited
+    std::unordered_set<vtkAlgorithm*> visitedFilters;
+    std::vector<vtkAlgorithm*> filters { EndFilter.Get() };
+    while (!filters.empty()) {
+        vtkAlgorithm* filter = filters.back();
+        filters.pop_back();
+
+        if (!visitedFilters.insert(filter).second)
+            continue;
+
+        if (auto* artifactFilter = ImageArtifactFilter::SafeDownCast(filter))
+            artifactFilter->SetOutputArtifactArrays(OutputArtifactArrays);
+
+        if (filter == StartFilter.Get())
+            continue;
+
+        for (int port = 0; port < filter->GetNumberOfInputPorts(); port++) {
+            for (int connection = 0; connection < filter->GetNumberOfInputConnections(port); connection++)
+                filters.push_back(filter->GetInputAlgorithm(port, connection));
+        }
+    }
+}
+
+auto ImageArtifactConcatenation::SetOutputArtifactArrays(bool outputArtifactArrays) -> void {
+    if (outputArtifactArrays == OutputArtifactArrays)
+        return;
+
+    OutputArtifactArrays = outputArtifactArrays;
+    UpdateArtifactFilter();
 }
 
 auto ImageArtifactConcatenation::GetFilterMTime() const noexcept -> vtkMTimeType {
     return EndFilter->GetMTime();
 }
 
+auto ImageArtifactConcatenation::SetNoiseSeed(uint64_t seed) const -> void {
+    for (uint16_t idx = 0;; idx++) {
+        uint16_t currentIdx = 0;
+        ImageArtifact const* imageArtifact = Start->Get(idx, currentIdx);
+        if (!imageArtifact)
+            return;
+
+        imageArtifact->SetNoiseSeed(seed, idx);
+    }
+}
+
 auto ImageArtifactConcatenation::GetStart() const noexcept -> ImageArtifact& {
     return *Start;
 }
@@ -38,6 +38,17 @@ public:
     [[nodiscard]] auto
     GetFilterMTime() const noexcept -> vtkMTimeType;
 
+    [[nodiscard]] auto
+    GetOutputArtifactArrays() const noexcept -> bool { return OutputArtifactArrays; }
+
+    /** Sets whether the filters output an array per artifact sub type, see ImageArtifactFilter */
+    auto
+    SetOutputArtifactArrays(bool outputArtifactArrays) -> void;
+
+    /** Sets the seed of the noise artifacts, each artifact draws from its own stream of the seed */
+    auto
+    SetNoiseSeed(uint64_t seed) const -> void;
+
     [[nodiscard]] auto
     GetStartFilter() const -> vtkImageAlgorithm&;
 
@@ -70,4 +81,5 @@ private:
     std::unique_ptr<ImageArtifact> Start; // Composite
     vtkNew<PassThroughImageArtifactFilter> StartFilter;
     vtkNew<PassThroughImageArtifactFilter> EndFilter;
+    bool OutputArtifactArrays = true;
 };
@@ -1,11 +1,14 @@
 #include "Pipeline.h"
 
+#include "Image/BasicImageArtifact.h"
 #include "Image/ImageArtifactConcatenation.h"
 #include "Structure/StructureArtifactListCollection.h"
 #include "../Modeling/CtDataSource.h"
 #include "../Modeling/CtStructureTree.h"
 #include "../PipelineGroups/ArtifactVariantPointer.h"
 
+#include <algorithm>
+
 Pipeline::Pipeline(CtStructureTree& structureTree, std::string name) :
         Name(name.empty()
                 ? "Pipeline " + std::to_string(PipelineId++)
@@ -64,6 +67,24 @@ auto Pipeline::GetImageArtifactsAlgorithm() const -> AlgorithmPipeline {
     return { ImageArtifactConcat->GetStartFilter(), ImageArtifactConcat->GetEndFilter() };
 }
 
+auto Pipeline::GetArtifactArrayOutput() const -> ArtifactArrayOutput {
+    return { TreeStructureArtifacts->GetOutputArtifactArrays(), ImageArtifactConcat->GetOutputArtifactArrays() };
+}
+
+auto Pipeline::SetArtifactArrayOutput(ArtifactArrayOutput output) const -> void {
+    TreeStructureArtifacts->SetOutputArtifactArrays(output.StructureArtifacts);
+    ImageArtifactConcat->SetOutputArtifactArrays(output.ImageArtifacts);
+}
+
+auto Pipeline::SetRequestedArrays(std::vector<std::string> const& arrayNames) const -> void {
+    auto const isRequested = [&arrayNames](auto const& subTypeNamePair) {
+        return std::ranges::find(arrayNames, subTypeNamePair.Name.toStdString()) != arrayNames.end();
+    };
+
+    SetArtifactArrayOutput({ std::ranges::any_of(StructureArtifactDetails::GetSubTypeValues(), isRequested),
+                             std::ranges::any_of(BasicImageArtifactDetails::GetSubTypeValues(), isRequested) });
+}
+
 void Pipeline::ProcessCtStructureTreeEvent(const CtStructureTreeEvent& event) const {
     switch (event.Type) {
         case CtStructureTreeEventType::ADD: {
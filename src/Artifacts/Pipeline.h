@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <vtkType.h>
 
@@ -52,6 +53,26 @@ public:
     [[nodiscard]] auto
     GetImageArtifactsAlgorithm() const -> AlgorithmPipeline;
 
+    /** Whether the structure and the image artifact filters output an array per artifact sub type */
+    struct ArtifactArrayOutput {
+        bool StructureArtifacts;
+        bool ImageArtifacts;
+    };
+
+    [[nodiscard]] auto
+    GetArtifactArrayOutput() const -> ArtifactArrayOutput;
+
+    auto
+    SetArtifactArrayOutput(ArtifactArrayOutput output) const -> void;
+
+    /**
+     * Lean mode: besides the radiodensities, the artifact filters only compute the artifact arrays requested
+     * by downstream consumers. Unrequested artifact arrays are never allocated.
+     * Lean mode is left by restoring the previous GetArtifactArrayOutput().
+     */
+    auto
+    SetRequestedArrays(std::vector<std::string> const& arrayNames) const -> void;
+
     auto
     ProcessCtStructureTreeEvent(const CtStructureTreeEvent& event) const -> void;
 
@@ -118,6 +118,19 @@ auto MetalArtifact::SetLength(float length) noexcept -> void {
     Modified();
 }
 
+auto MetalArtifact::GetInfluenceDistance(float maxRadiodensity, float epsilon) const noexcept -> float {
+    float const maxContribution = maxRadiodensity * std::abs(MaxAttenuationChangeFactor);
+    if (maxContribution <= epsilon)
+        return 0.0F;
+
+    // the contributions fall off linearly with the distance and vanish at Length
+    return Length * (1.0F - epsilon / maxContribution);
+}
+
+auto MetalArtifact::GetParameterValues() const -> std::vector<double> {
+    return { DirectionHighestAttenuation[0], DirectionHighestAttenuation[1], MaxAttenuationFactor, Length };
+}
+
 auto MetalArtifact::GetProperties() noexcept -> PipelineParameterProperties {
     PipelineParameterProperties properties;
     properties.Add(
@@ -136,17 +149,18 @@ auto MetalArtifact::GetProperties() noexcept -> PipelineParameterProperties {
 auto MetalArtifact::EvaluateAtPosition(DoublePoint const& point,
                                        float maxRadiodensity,
                                        bool pointOccupiedByStructure,
+                                       std::optional<DoublePoint> const& closestXYPoint,
                                        CtStructureTree const& structureTree,
                                        CtStructureVariant const& structure,
-                                       std::array<double, 3> /*spacing*/) const noexcept -> float {
+                                       std::array<double, 3> /*spacing*/,
+                                       EvaluationPrecision precision) const noexcept -> float {
     if (pointOccupiedByStructure || maxRadiodensity < 0.0F)
         return 0.0F;
 
-    auto const closestXYPoint = structureTree.ClosestPointOnXYPlane(point, structure);
     if (!closestXYPoint || point == *closestXYPoint)
         return 0.0F;
 
-    if (auto const radiodensity = structureTree.FunctionValueAndRadiodensity(point, &structure).Radiodensity;
+    if (auto const radiodensity = structureTree.FunctionValueAndRadiodensity(point, &structure, precision).Radiodensity;
         radiodensity <= 0.0F)
         return 0.0F;
 
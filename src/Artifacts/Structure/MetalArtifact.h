@@ -9,9 +9,12 @@
 #include <vtkVector.h>
 
 #include <array>
+#include <optional>
+#include <vector>
 
 class CtStructureTree;
 class CtStructureVariant;
+enum struct EvaluationPrecision : uint8_t;
 
 struct MetalArtifactData;
 
@@ -41,9 +44,11 @@ public:
     EvaluateAtPosition(DoublePoint const& point,
                        float maxRadiodensity,
                        bool pointOccupiedByStructure,
+                       std::optional<DoublePoint> const& closestXYPoint,
                        CtStructureTree const& structureTree,
                        CtStructureVariant const& structure,
-                       std::array<double, 3> spacing) const noexcept -> float;
+                       std::array<double, 3> spacing,
+                       EvaluationPrecision precision) const noexcept -> float;
 
     [[nodiscard]] auto
     GetLength() const noexcept -> float { return Length; }
@@ -51,9 +56,20 @@ public:
     auto
     SetLength(float length) noexcept -> void;
 
+    /**
+     * In-plane distance from the structure beyond which all contributions of the artifact are below epsilon,
+     * 0 if there are none above it
+     */
+    [[nodiscard]] auto
+    GetInfluenceDistance(float maxRadiodensity, float epsilon) const noexcept -> float;
+
     [[nodiscard]] auto
     GetProperties() noexcept -> PipelineParameterProperties;
 
+    /** The parameters that determine the artifact's values */
+    [[nodiscard]] auto
+    GetParameterValues() const -> std::vector<double>;
+
     [[nodiscard]] auto
     GetMTime() const noexcept -> vtkMTimeType { return MTime; }
 
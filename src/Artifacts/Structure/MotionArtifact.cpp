@@ -6,7 +6,10 @@
 #include <QFormLayout>
 #include <QGroupBox>
 
+#include <algorithm>
 #include <numbers>
+#include <numeric>
+#include <stdexcept>
 
 
 auto MotionArtifactData::PopulateFromArtifact(MotionArtifact const& artifact) noexcept -> void {
@@ -117,52 +120,111 @@ auto MotionArtifact::SetTransform(SimpleTransformData const& data) noexcept -> v
 auto MotionArtifact::EvaluateAtPosition(DoublePoint const& point,
                                         float /*maxRadiodensity*/,
                                         bool const pointOccupiedByStructure,
+                                        std::optional<DoublePoint> const& /*closestXYPoint*/,
                                         CtStructureTree const& structureTree,
                                         CtStructureVariant const& structure,
-                                        std::array<double, 3> const& spacing) const noexcept -> float {
+                                        std::array<double, 3> const& spacing,
+                                        EvaluationPrecision precision) const noexcept -> float {
     if (pointOccupiedByStructure)
         return 0.0F;
 
     DoublePoint const transformedPoint = Transform.TransformPoint(point);
 
-    auto const functionValueRadiodensity = structureTree.FunctionValueAndRadiodensity(transformedPoint, &structure);
+    return HasBlur()
+            ? BlurredStructureRadiodensity(transformedPoint, structureTree, structure, spacing, precision)
+            : StructureRadiodensity(transformedPoint, structureTree, structure, precision);
+}
 
-    float const result = functionValueRadiodensity.FunctionValue < 0.0F
-            ? functionValueRadiodensity.Radiodensity * RadiodensityFactor
-            : 0.0F;
+auto MotionArtifact::EvaluateSlice(DoublePoint const& sliceStartPoint,
+                                   std::array<int, 2> sliceDimensions,
+                                   CtStructureTree const& structureTree,
+                                   CtStructureVariant const& structure,
+                                   std::array<double, 3> const& spacing,
+                                   EvaluationPrecision precision,
+                                   std::span<float> sliceValues) const -> void {
+    auto const [ width, height ] = sliceDimensions;
+    if (sliceValues.size() != static_cast<size_t>(width) * height)
+        throw std::runtime_error("slice values must match the slice dimensions");
+
+    if (HasBlur() && !PreservesSliceAxes()) {
+        // the blur windows of neighboring points do not overlap in the transformed frame
+        for (int y = 0; y < height; y++) {
+            DoublePoint point { sliceStartPoint[0], sliceStartPoint[1] + y * spacing[1], sliceStartPoint[2] };
+
+            for (int x = 0; x < width; x++) {
+                sliceValues[y * width + x] = BlurredStructureRadiodensity(Transform.TransformPoint(point),
+                                                                          structureTree, structure,
+                                                                          spacing, precision);
+                point[0] += spacing[0];
+            }
+        }
 
-    if (KernelRadius < 1 || KernelSd <= 0.0F)
-        return result;
+        return;
+    }
 
-    std::vector<float> convolvedValues { Kernel2D.size(), std::allocator<float>{} };
-    {
-        size_t const kernel1DSize = KernelRadius * 2 + 1;
+    // the slice grid maps onto a grid along the x and y axes of the transformed frame,
+    // which is where the blur offsets are taken
+    int const radius = HasBlur() ? KernelRadius : 0;
+    int const paddedWidth = width + 2 * radius;
+    int const paddedHeight = height + 2 * radius;
+    DoublePoint const transformedStartPoint = Transform.TransformPoint(sliceStartPoint);
+
+    auto rasterise = [&](std::span<float> mask) {
+        for (int y = 0; y < paddedHeight; y++) {
+            DoublePoint point { transformedStartPoint[0] - radius * spacing[0],
+                                transformedStartPoint[1] + (y - radius) * spacing[1],
+                                transformedStartPoint[2] };
+
+            for (int x = 0; x < paddedWidth; x++) {
+                mask[y * paddedWidth + x] = StructureRadiodensity(point, structureTree, structure, precision);
+                point[0] += spacing[0];
+            }
+        }
+    };
 
-        DoublePoint pointOther { transformedPoint[0],
-                                 transformedPoint[1] - KernelRadius * spacing[1],
-                                 transformedPoint[2] };
+    if (radius == 0) {
+        rasterise(sliceValues);
+        return;
+    }
 
-        for (size_t iOther = 0; iOther < kernel1DSize; ++iOther) {
-            DoublePoint pointBlur { pointOther[0] - KernelRadius * spacing[0],
-                                    pointOther[1],
-                                    pointOther[2] };
+    std::vector<float> mask(static_cast<size_t>(paddedWidth) * paddedHeight);
+    rasterise(mask);
 
-            for (size_t iBlur = 0; iBlur < kernel1DSize; ++iBlur) {
-                auto const kernelResult = structureTree.FunctionValueAndRadiodensity(pointBlur, &structure);
-                size_t const idx = iOther * kernel1DSize + iBlur;
-                convolvedValues[idx] = kernelResult.FunctionValue < 0.0F
-                                               ? kernelResult.Radiodensity * RadiodensityFactor
-                                               : 0.0F;
-                convolvedValues[idx] *= Kernel2D[idx];
+    int const kernelSize = 2 * radius + 1;
 
-                pointBlur[0] += spacing[0];
-            }
+    std::vector<float> xBlurred(static_cast<size_t>(width) * paddedHeight, 0.0F);
+    for (int y = 0; y < paddedHeight; y++) {
+        float const* const maskRow = &mask[y * paddedWidth];
+        float* const xBlurredRow = &xBlurred[y * width];
+
+        for (int k = 0; k < kernelSize; k++) {
+            float const weight = KernelX[k];
+            float const* const shiftedMaskRow = std::next(maskRow, k);
+
+            for (int x = 0; x < width; x++)
+                xBlurredRow[x] += weight * shiftedMaskRow[x];
+        }
+    }
 
-            pointOther[1] += spacing[1];
+    std::ranges::fill(sliceValues, 0.0F);
+    for (int y = 0; y < height; y++) {
+        float* const valuesRow = &sliceValues[y * width];
+
+        for (int k = 0; k < kernelSize; k++) {
+            float const weight = KernelY[k];
+            float const* const xBlurredRow = &xBlurred[(y + k) * width];
+
+            for (int x = 0; x < width; x++)
+                valuesRow[x] += weight * xBlurredRow[x];
         }
     }
+}
 
-    return std::reduce(convolvedValues.begin(), convolvedValues.end());
+auto MotionArtifact::GetParameterValues() const -> std::vector<double> {
+    std::vector<double> values { RadiodensityFactor, static_cast<double>(KernelRadius), KernelSd };
+    for (auto const& vector : Transform.GetData())
+        values.insert(values.end(), vector.cbegin(), vector.cend());
+    return values;
 }
 
 auto MotionArtifact::GetProperties() noexcept -> PipelineParameterProperties {
@@ -181,23 +243,68 @@ auto MotionArtifact::GetProperties() noexcept -> PipelineParameterProperties {
 }
 
 auto MotionArtifact::UpdateKernel() noexcept -> void {
-    static constexpr auto gaussianFunction = [](double sd, double x, double y) {
-        double const twoVariance = 2.0 * sd * sd;
-        return 1.0 / std::sqrt(std::numbers::pi * twoVariance) * std::exp(-(x * x + y * y / twoVariance));
+    // the 2D kernel exp(-(dy² + dx² / 2sd²)) is separable into a blur with standard deviation sd along x
+    // and one of fixed width along y
+    static constexpr auto gaussianFunction = [](double twoVariance, double x) {
+        return 1.0 / std::sqrt(std::numbers::pi * twoVariance) * std::exp(-(x * x / twoVariance));
     };
 
-    size_t const kernel1DSize = KernelRadius * 2 + 1;
+    auto createKernel = [this](double twoVariance) {
+        size_t const kernelSize = KernelRadius * 2 + 1;
 
-    Kernel2D.clear();
-    Kernel2D.resize(kernel1DSize * kernel1DSize);
+        std::vector<double> weights(kernelSize);
+        for (int i = 0; i < kernelSize; ++i)
+            weights[i] = gaussianFunction(twoVariance, i - KernelRadius);
 
-    for (int i = 0; i < kernel1DSize; ++i)
-        for (int j = 0; j < kernel1DSize; ++j)
-            Kernel2D[i * kernel1DSize + j] = static_cast<float>(
-                    gaussianFunction(KernelSd, i - KernelRadius, j - KernelRadius));
+        double const weightSum = std::reduce(weights.begin(), weights.end());
+
+        std::vector<float> kernel(kernelSize);
+        std::ranges::transform(weights, kernel.begin(),
+                               [weightSum](double weight) { return static_cast<float>(weight / weightSum); });
+        return kernel;
+    };
+
+    KernelX = createKernel(2.0 * KernelSd * KernelSd);
+    KernelY = createKernel(1.0);
+}
+
+auto MotionArtifact::PreservesSliceAxes() const noexcept -> bool {
+    RowMajor4x3Matrix const& matrix = Transform.GetMatrix();
+    return matrix(0, 0) == 1.0 && matrix(1, 0) == 0.0 && matrix(2, 0) == 0.0
+            && matrix(0, 1) == 0.0 && matrix(1, 1) == 1.0 && matrix(2, 1) == 0.0;
+}
 
-    float const kernelSum = std::reduce(Kernel2D.begin(), Kernel2D.end());
+auto MotionArtifact::StructureRadiodensity(DoublePoint const& transformedPoint,
+                                           CtStructureTree const& structureTree,
+                                           CtStructureVariant const& structure,
+                                           EvaluationPrecision precision) const noexcept -> float {
+    auto const functionValueRadiodensity
+            = structureTree.FunctionValueAndRadiodensity(transformedPoint, &structure, precision);
+
+    return functionValueRadiodensity.FunctionValue < 0.0F
+            ? functionValueRadiodensity.Radiodensity * RadiodensityFactor
+            : 0.0F;
+}
+
+auto MotionArtifact::BlurredStructureRadiodensity(DoublePoint const& transformedPoint,
+                                                  CtStructureTree const& structureTree,
+                                                  CtStructureVariant const& structure,
+                                                  std::array<double, 3> const& spacing,
+                                                  EvaluationPrecision precision) const noexcept -> float {
+    float result = 0.0F;
+    for (int dy = -KernelRadius; dy <= KernelRadius; dy++) {
+        float xBlurred = 0.0F;
+        for (int dx = -KernelRadius; dx <= KernelRadius; dx++) {
+            DoublePoint const pointBlur { transformedPoint[0] + dx * spacing[0],
+                                          transformedPoint[1] + dy * spacing[1],
+                                          transformedPoint[2] };
+
+            xBlurred += KernelX[dx + KernelRadius]
+                    * StructureRadiodensity(pointBlur, structureTree, structure, precision);
+        }
+
+        result += KernelY[dy + KernelRadius] * xBlurred;
+    }
 
-    for (float& value : Kernel2D)
-        value /= kernelSum;
+    return result;
 }
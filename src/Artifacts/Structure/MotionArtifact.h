@@ -9,9 +9,14 @@
 #include <vtkTransform.h>
 
 #include <array>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
 
 class CtStructureTree;
 class CtStructureVariant;
+enum struct EvaluationPrecision : uint8_t;
 
 struct MotionArtifactData;
 
@@ -51,13 +56,41 @@ public:
     EvaluateAtPosition(DoublePoint const& point,
                        float maxRadiodensity,
                        bool pointOccupiedByStructure,
+                       std::optional<DoublePoint> const& closestXYPoint,
                        CtStructureTree const& structureTree,
                        CtStructureVariant const& structure,
-                       std::array<double, 3> const& spacing) const noexcept -> float;
+                       std::array<double, 3> const& spacing,
+                       EvaluationPrecision precision) const noexcept -> float;
+
+    /**
+     * Evaluates the artifact for all points of a z-slice of an image grid, regardless of whether they are occupied
+     * by the structure.
+     * If the transform keeps the slice axes, the moved structure is rasterised once into a radiodensity mask padded
+     * by the kernel radius, which is then blurred by separable 1D passes along x and y. Otherwise the blur windows
+     * of the points are not shared and every point is blurred on its own.
+     */
+    auto
+    EvaluateSlice(DoublePoint const& sliceStartPoint,
+                  std::array<int, 2> sliceDimensions,
+                  CtStructureTree const& structureTree,
+                  CtStructureVariant const& structure,
+                  std::array<double, 3> const& spacing,
+                  EvaluationPrecision precision,
+                  std::span<float> sliceValues) const -> void;
+
+    /** Motion artifacts may reach any point, as the structure is moved and blurred */
+    [[nodiscard]] auto
+    GetInfluenceDistance(float /*maxRadiodensity*/, float /*epsilon*/) const noexcept -> float {
+        return std::numeric_limits<float>::infinity();
+    }
 
     [[nodiscard]] auto
     GetProperties() noexcept -> PipelineParameterProperties;
 
+    /** The parameters that determine the artifact's values */
+    [[nodiscard]] auto
+    GetParameterValues() const -> std::vector<double>;
+
     [[nodiscard]] auto
     GetMTime() const noexcept -> vtkMTimeType { return MTime; }
 
@@ -70,11 +103,34 @@ private:
     auto
     UpdateKernel() noexcept -> void;
 
+    [[nodiscard]] auto
+    HasBlur() const noexcept -> bool { return KernelRadius >= 1 && KernelSd > 0.0F; }
+
+    /** Whether the transform maps the x and y axes of a slice onto themselves, so that only its offset remains */
+    [[nodiscard]] auto
+    PreservesSliceAxes() const noexcept -> bool;
+
+    /** Scaled radiodensity of the structure at an already transformed point, 0 outside of it */
+    [[nodiscard]] auto
+    StructureRadiodensity(DoublePoint const& transformedPoint,
+                          CtStructureTree const& structureTree,
+                          CtStructureVariant const& structure,
+                          EvaluationPrecision precision) const noexcept -> float;
+
+    /** StructureRadiodensity blurred by the kernel, whose offsets are taken in the transformed frame */
+    [[nodiscard]] auto
+    BlurredStructureRadiodensity(DoublePoint const& transformedPoint,
+                                 CtStructureTree const& structureTree,
+                                 CtStructureVariant const& structure,
+                                 std::array<double, 3> const& spacing,
+                                 EvaluationPrecision precision) const noexcept -> float;
+
     float RadiodensityFactor = 0.0F;
     uint16_t KernelRadius = 0;
     float KernelSd = 1.0F;
     SimpleTransform Transform;
-    std::vector<float> Kernel2D;
+    std::vector<float> KernelX; // weights of the offsets -KernelRadius to KernelRadius along x
+    std::vector<float> KernelY; // weights of the offsets -KernelRadius to KernelRadius along y
 
     vtkTimeStamp MTime;
 };
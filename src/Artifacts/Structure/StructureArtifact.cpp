@@ -20,6 +20,15 @@ auto StructureArtifact::GetProperties() noexcept -> PipelineParameterProperties
     return std::visit([](auto& artifact) { return artifact.GetProperties(); }, Artifact);
 }
 
+auto StructureArtifact::GetParameterValues() const -> std::vector<double> {
+    std::vector<double> values { static_cast<double>(GetSubType()) };
+    std::vector<double> const artifactValues = std::visit([](auto const& artifact) {
+        return artifact.GetParameterValues();
+    }, Artifact);
+    values.insert(values.end(), artifactValues.cbegin(), artifactValues.cend());
+    return values;
+}
+
 auto StructureArtifact::GetSubType() const noexcept -> SubType {
     return GetSubType(Artifact);
 }
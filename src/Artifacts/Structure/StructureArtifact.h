@@ -12,6 +12,7 @@
 
 #include <string>
 #include <variant>
+#include <vector>
 
 class CtStructureTree;
 class CtStructureVariant;
@@ -123,22 +124,42 @@ public:
     EvaluateAtPosition(DoublePoint const& point,
                        float maxRadiodensity,
                        bool pointOccupiedByStructure,
+                       std::optional<DoublePoint> const& closestXYPoint,
                        CtStructureTree const& structureTree,
                        CtStructureVariant const& structure,
-                       std::array<double, 3> spacing) const noexcept -> float {
+                       std::array<double, 3> spacing,
+                       EvaluationPrecision precision) const noexcept -> float {
         return std::visit([&](auto const& artifact)
                                   { return artifact.EvaluateAtPosition(point,
                                                                        maxRadiodensity,
                                                                        pointOccupiedByStructure,
+                                                                       closestXYPoint,
                                                                        structureTree,
                                                                        structure,
-                                                                       spacing); },
+                                                                       spacing,
+                                                                       precision); },
                           Artifact);
     }
 
+    /** In-plane distance from the structure beyond which all contributions are below epsilon */
+    [[nodiscard]] auto
+    GetInfluenceDistance(float maxRadiodensity, float epsilon) const noexcept -> float {
+        return std::visit([=](auto const& artifact) { return artifact.GetInfluenceDistance(maxRadiodensity, epsilon); },
+                          Artifact);
+    }
+
+    /** The sub type followed by the parameters that determine the artifact's values */
+    [[nodiscard]] auto
+    GetParameterValues() const -> std::vector<double>;
+
     [[nodiscard]] auto
     GetSubType() const noexcept -> SubType;
 
+    /** The concrete artifact, nullptr if it is of another sub type */
+    template<typename SubTypeArtifact>
+    [[nodiscard]] auto
+    GetSubTypeArtifact() const noexcept -> SubTypeArtifact const* { return std::get_if<SubTypeArtifact>(&Artifact); }
+
     [[nodiscard]] auto
     operator== (StructureArtifact const& other) const noexcept -> bool { return GetMTime() == other.GetMTime(); }
 
@@ -0,0 +1,69 @@
+#include "StructureArtifactContributionCache.h"
+
+#include "../../Utils/System.h"
+
+#include <algorithm>
+
+
+StructureArtifactContributionCache::Contribution::Contribution(std::array<int, 6> const& extent) :
+        Extent(extent),
+        Values(static_cast<size_t>(extent[1] - extent[0] + 1)
+                       * (extent[3] - extent[2] + 1)
+                       * (extent[5] - extent[4] + 1),
+               0.0F) {}
+
+StructureArtifactContributionCache::StructureArtifactContributionCache(uint64_t maxSizeInBytes) :
+        MaxSizeInBytes(maxSizeInBytes) {}
+
+auto StructureArtifactContributionCache::GetShared() -> StructureArtifactContributionCache& {
+    static StructureArtifactContributionCache cache { System::GetMaxApplicationMemory() / 8 };
+    return cache;
+}
+
+auto StructureArtifactContributionCache::Contribution::GetSizeInBytes(std::array<int, 6> const& extent) noexcept
+        -> uint64_t {
+    uint64_t const numberOfVoxels = static_cast<uint64_t>(extent[1] - extent[0] + 1)
+            * (extent[3] - extent[2] + 1)
+            * (extent[5] - extent[4] + 1);
+    return numberOfVoxels * sizeof(float);
+}
+
+auto StructureArtifactContributionCache::Find(Key const& key) -> std::shared_ptr<Contribution const> {
+    std::scoped_lock const lock { Mutex };
+
+    auto const it = std::ranges::find(Entries, key, &decltype(Entries)::value_type::first);
+    if (it == Entries.end())
+        return nullptr;
+
+    Entries.splice(Entries.begin(), Entries, it);
+    return Entries.front().second;
+}
+
+auto StructureArtifactContributionCache::Insert(Key const& key,
+                                                std::shared_ptr<Contribution const> contribution) -> void {
+    std::scoped_lock const lock { Mutex };
+
+    uint64_t const sizeInBytes = contribution->Values.size() * sizeof(float);
+    if (sizeInBytes > MaxSizeInBytes)
+        return;
+
+    if (auto const it = std::ranges::find(Entries, key, &decltype(Entries)::value_type::first); it != Entries.end()) {
+        SizeInBytes -= it->second->Values.size() * sizeof(float);
+        Entries.erase(it);
+    }
+
+    while (SizeInBytes + sizeInBytes > MaxSizeInBytes) {
+        SizeInBytes -= Entries.back().second->Values.size() * sizeof(float);
+        Entries.pop_back();
+    }
+
+    Entries.emplace_front(key, std::move(contribution));
+    SizeInBytes += sizeInBytes;
+}
+
+auto StructureArtifactContributionCache::Clear() noexcept -> void {
+    std::scoped_lock const lock { Mutex };
+
+    Entries.clear();
+    SizeInBytes = 0;
+}
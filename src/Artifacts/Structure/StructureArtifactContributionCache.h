@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vtkType.h>
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class CtStructureVariant;
+class vtkImageData;
+enum struct EvaluationPrecision : uint8_t;
+
+
+/**
+ * Contribution fields of individual structure artifacts, reused as long as the artifact's parameters,
+ * the structure tree and the input volume are unchanged, e.g. across parameter space states that only vary other
+ * artifacts. The least recently used fields are evicted once the memory budget is exceeded.
+ * The structure artifact filters of all pipelines share one cache, so that their memory is budgeted once.
+ */
+class StructureArtifactContributionCache {
+public:
+    struct Key {
+        std::size_t ParameterHash; // of the parameter values, so that most other keys are rejected cheaply
+        std::vector<double> ParameterValues; // compared in full, a hash collision must not reuse a contribution
+        CtStructureVariant const* Structure;
+        vtkMTimeType TreeMTime;
+        vtkImageData const* Input; // the filters share the cache, so the MTime alone does not identify the input
+        vtkMTimeType InputMTime;
+        EvaluationPrecision Precision;
+
+        [[nodiscard]] auto
+        operator==(Key const&) const noexcept -> bool = default;
+    };
+
+    /** Values of an artifact within the voxel extent { x1, x2, y1, y2, z1, z2 }, x fastest */
+    struct Contribution {
+        std::array<int, 6> Extent;
+        std::vector<float> Values;
+
+        explicit Contribution(std::array<int, 6> const& extent);
+
+        [[nodiscard]] auto static
+        GetSizeInBytes(std::array<int, 6> const& extent) noexcept -> uint64_t;
+
+        [[nodiscard]] auto
+        GetIndex(int x, int y, int z) const noexcept -> vtkIdType {
+            return (static_cast<vtkIdType>(z - Extent[4]) * (Extent[3] - Extent[2] + 1) + (y - Extent[2]))
+                    * (Extent[1] - Extent[0] + 1) + (x - Extent[0]);
+        }
+    };
+
+    explicit StructureArtifactContributionCache(uint64_t maxSizeInBytes);
+
+    /** The cache of all structure artifact filters, budgeted with an eighth of the application memory */
+    [[nodiscard]] static auto
+    GetShared() -> StructureArtifactContributionCache&;
+
+    [[nodiscard]] auto
+    GetMaxSizeInBytes() const noexcept -> uint64_t { return MaxSizeInBytes; }
+
+    /** The cached contribution for the key, nullptr if there is none */
+    [[nodiscard]] auto
+    Find(Key const& key) -> std::shared_ptr<Contribution const>;
+
+    /** Caches the contribution unless it exceeds the memory budget on its own */
+    auto
+    Insert(Key const& key, std::shared_ptr<Contribution const> contribution) -> void;
+
+    auto
+    Clear() noexcept -> void;
+
+private:
+    std::mutex Mutex;
+    uint64_t MaxSizeInBytes;
+    uint64_t SizeInBytes = 0;
+    std::list<std::pair<Key, std::shared_ptr<Contribution const>>> Entries; // most recently used first
+};
@@ -155,6 +155,14 @@ auto TreeStructureArtifactListCollection::GetFilter() const -> vtkImageAlgorithm
     return *Filter;
 }
 
+auto TreeStructureArtifactListCollection::GetOutputArtifactArrays() const -> bool {
+    return Filter->GetOutputArtifactArrays();
+}
+
+auto TreeStructureArtifactListCollection::SetOutputArtifactArrays(bool outputArtifactArrays) const -> void {
+    Filter->SetOutputArtifactArrays(outputArtifactArrays);
+}
+
 auto TreeStructureArtifactListCollection::GetStructureArtifactList(StructureArtifact const& structureArtifact) const
         -> StructureArtifactList const& {
 
@@ -125,6 +125,13 @@ public:
     [[nodiscard]] auto
     GetFilter() const -> vtkImageAlgorithm&;
 
+    [[nodiscard]] auto
+    GetOutputArtifactArrays() const -> bool;
+
+    /** Sets whether the filter outputs an array per artifact sub type, see StructureArtifactsFilter */
+    auto
+    SetOutputArtifactArrays(bool outputArtifactArrays) const -> void;
+
     [[nodiscard]] auto
     GetStructureArtifactList(StructureArtifact const& structureArtifact) const -> StructureArtifactList const&;
 
@@ -1,7 +1,9 @@
 #include "StructureArtifactsFilter.h"
 
 #include "StructureArtifactListCollection.h"
+#include "StructureSliceDistanceMap.h"
 #include "../../Modeling/CtStructureTree.h"
+#include "../../Utils/Hash.h"
 #include "../../Utils/ImageDataUtils.h"
 
 #include <vtkErrorCode.h>
@@ -13,9 +15,14 @@
 #include <vtkPointData.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
-#include <vtkSMPTools.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
-#include <vtkTypeUInt16Array.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
 
 vtkStandardNewMacro(StructureArtifactsFilter)
 
@@ -57,6 +64,22 @@ auto StructureArtifactsFilter::SetStructureArtifactCollection(
     Modified();
 }
 
+auto StructureArtifactsFilter::SetEvaluationPrecision(EvaluationPrecision precision) -> void {
+    if (precision == Precision)
+        return;
+
+    Precision = precision;
+    Modified();
+}
+
+auto StructureArtifactsFilter::SetOutputArtifactArrays(bool outputArtifactArrays) -> void {
+    if (outputArtifactArrays == OutputArtifactArrays)
+        return;
+
+    OutputArtifactArrays = outputArtifactArrays;
+    Modified();
+}
+
 auto StructureArtifactsFilter::RequestInformation(vtkInformation* request,
                                                   vtkInformationVector** inputVector,
                                                   vtkInformationVector *outputVector) -> int {
@@ -103,8 +126,29 @@ auto StructureArtifactsFilter::RequestData(vtkInformation* request, vtkInformati
     SetErrorCode(vtkErrorCode::NoError);
 
 
-    auto* structureIdArray = vtkTypeUInt16Array::SafeDownCast(
+    auto const* structureIds = BrickSparseDataArray<StructureId>::SafeDownCast(
             output->GetPointData()->GetAbstractArray("BasicStructureIds"));
+    if (!structureIds) {
+        vtkErrorMacro("Input has no brick-sparse basic structure id array");
+        return 0;
+    }
+
+    using StructureArtifactsMap = TreeStructureArtifactListCollection::StructureArtifactsMap;
+
+    std::array<StructureArtifactsMap, NumberOfSubTypes> artifactsMaps;
+    for_<NumberOfSubTypes>([this, &artifactsMaps](auto iCounter) {
+        auto const i = iCounter.value;
+        artifactsMaps[i] = StructureArtifactCollection->GetStructureArtifacts<static_cast<SubType>(i)>();
+    });
+
+    std::array<bool, NumberOfSubTypes> subTypeHasArtifacts {};
+    std::ranges::transform(artifactsMaps, subTypeHasArtifacts.begin(), [](StructureArtifactsMap const& artifactsMap) {
+        return std::ranges::any_of(artifactsMap, [](auto const& entry) { return !entry.second.empty(); });
+    });
+
+    // without artifacts the input arrays are passed on unchanged, otherwise only the modified arrays are allocated
+    if (std::ranges::none_of(subTypeHasArtifacts, std::identity {}))
+        return 1;
 
     vtkNew<vtkFloatArray> const radiodensityArray;
     auto* inputRadiodensityArray = vtkFloatArray::SafeDownCast(
@@ -113,66 +157,124 @@ auto StructureArtifactsFilter::RequestData(vtkInformation* request, vtkInformati
     output->GetPointData()->AddArray(radiodensityArray);
 
     vtkIdType const numberOfPoints = output->GetNumberOfPoints();
-    vtkNew<vtkFloatArray> const motionArtifactArray;
-    motionArtifactArray->SetNumberOfComponents(1);
-    motionArtifactArray->SetName(GetArrayName(SubType::MOTION).data());
-    motionArtifactArray->SetNumberOfTuples(numberOfPoints);
-    motionArtifactArray->FillValue(0.0F);
-    output->GetPointData()->AddArray(motionArtifactArray);
-
-    vtkNew<vtkFloatArray> const metallicArtifactArray;
-    metallicArtifactArray->SetNumberOfComponents(1);
-    metallicArtifactArray->SetName(GetArrayName(SubType::METAL).data());
-    metallicArtifactArray->SetNumberOfTuples(numberOfPoints);
-    metallicArtifactArray->FillValue(0.0F);
-    output->GetPointData()->AddArray(metallicArtifactArray);
-
-    vtkNew<vtkFloatArray> const windmillArtifactArray;
-    windmillArtifactArray->SetNumberOfComponents(1);
-    windmillArtifactArray->SetName(GetArrayName(SubType::WINDMILL).data());
-    windmillArtifactArray->SetNumberOfTuples(numberOfPoints);
-    windmillArtifactArray->FillValue(0.0F);
-    output->GetPointData()->AddArray(windmillArtifactArray);
-
-    StructureId const* const structureIds = structureIdArray->WritePointer(0, numberOfPoints);
     float* const radiodensities = radiodensityArray->WritePointer(0, numberOfPoints);
-    float* const motionValues = motionArtifactArray->WritePointer(0, numberOfPoints);
-    float* const metallicValues = metallicArtifactArray->WritePointer(0, numberOfPoints);
-    float* const windmillValues = windmillArtifactArray->WritePointer(0, numberOfPoints);
-    std::array<float* const,
-               StructureArtifactDetails::GetNumberOfSubTypeValues()> const artifactArrays { motionValues,
-                                                                                            metallicValues,
-                                                                                            windmillValues };
-    for_<StructureArtifactDetails::GetNumberOfSubTypeValues()>([this, output, radiodensities,
-                                                                structureIds, artifactArrays,
-                                                                numberOfPoints](auto iCounter) {
 
-        auto const i = iCounter.value;
-        auto const ArtifactType = static_cast<SubType>(i);
+    std::array<float*, NumberOfSubTypes> artifactArrays {};
+    for (int i = 0; i < NumberOfSubTypes; i++) {
+        if (!OutputArtifactArrays || !subTypeHasArtifacts[i])
+            continue;
+
+        vtkNew<vtkFloatArray> const artifactArray;
+        artifactArray->SetNumberOfComponents(1);
+        artifactArray->SetName(GetArrayName(static_cast<SubType>(i)).data());
+        artifactArray->SetNumberOfTuples(numberOfPoints);
+        output->GetPointData()->AddArray(artifactArray);
+        artifactArrays[i] = artifactArray->WritePointer(0, numberOfPoints);
+    }
 
-        TreeStructureArtifactListCollection::StructureArtifactsMap const artifactsMap
-                = StructureArtifactCollection->GetStructureArtifacts<ArtifactType>();
+    ImageDataUtils::Grid const grid { *output };
+    std::array<int, 3> const& dimensions = grid.Dimensions;
+    std::array<double, 3> const& spacing = grid.Spacing;
+    DoublePoint const& startPoint = grid.StartPoint;
 
-        for (auto const& [ structure, artifacts ] : artifactsMap) {
-            for (auto const& artifact : artifacts) {
-                Algorithm algorithm { this, StructureTree, output, &structure.get(), &artifact.get(),
-                                      radiodensities, structureIds, artifactArrays[i] };
+    StructureVoxelIndex const voxelIndex { *structureIds };
+
+    // computed once per structure and shared by all artifacts of the structure
+    std::map<CtStructureVariant const*, std::vector<StructureVoxelIndex::Run>> structureRuns;
+    auto getStructureRuns = [&](CtStructureVariant const& structure) -> std::vector<StructureVoxelIndex::Run> const& {
+        auto const it = structureRuns.find(&structure);
+        if (it != structureRuns.end())
+            return it->second;
 
-                vtkSMPTools::For(0, numberOfPoints, algorithm);
+        return structureRuns[&structure] = voxelIndex.GetRuns(StructureTree->GetBasicStructureIds(structure));
+    };
+
+    std::map<CtStructureVariant const*, std::unique_ptr<StructureSliceDistanceMap>> distanceMaps;
+    auto getDistanceMap = [&](CtStructureVariant const& structure) -> StructureSliceDistanceMap const* {
+        auto& distanceMap = distanceMaps[&structure];
+        if (!distanceMap)
+            distanceMap = std::make_unique<StructureSliceDistanceMap>(*structureIds,
+                                                                      StructureTree->GetBasicStructureIds(structure),
+                                                                      startPoint,
+                                                                      spacing);
+        return distanceMap.get();
+    };
+
+    using ContributionKey = StructureArtifactContributionCache::Key;
+    using Contribution = StructureArtifactContributionCache::Contribution;
+    auto& contributionCache = StructureArtifactContributionCache::GetShared();
+    std::vector<std::pair<ContributionKey, std::shared_ptr<Contribution>>> evaluatedContributions;
+    uint64_t evaluatedContributionsSizeInBytes = 0; // contributions beyond the cache budget are only fused
+    std::vector<std::shared_ptr<Contribution const>> cachedContributions;
+
+    std::vector<ArtifactCandidate> candidates;
+    for (int i = 0; i < NumberOfSubTypes; i++) {
+        auto const artifactType = static_cast<SubType>(i);
+
+        for (auto const& [ structure, artifacts ] : artifactsMaps[i]) {
+            if (artifacts.empty())
+                continue;
+
+            std::vector<StructureVoxelIndex::Run> const& runs = getStructureRuns(structure.get());
+            auto const structureExtent = voxelIndex.GetExtent(runs);
+            float const maxStructureRadiodensity = StructureTree->GetMaxTissueValue(structure.get());
+
+            for (auto const& artifact : artifacts) {
+                float const influenceDistance = artifact.get().GetInfluenceDistance(maxStructureRadiodensity,
+                                                                                    ContributionEpsilon);
+
+                // unbounded artifacts may reach any voxel, bounded ones only the slices containing the structure
+                // up to their influence distance around it
+                std::array<int, 6> extent { 0, dimensions[0] - 1, 0, dimensions[1] - 1, 0, dimensions[2] - 1 };
+                bool const isBounded = std::isfinite(influenceDistance);
+                if (isBounded) {
+                    if (!structureExtent || influenceDistance <= 0.0F)
+                        continue;
+
+                    for (int d = 0; d < 2; d++) {
+                        auto const margin = static_cast<int>(std::ceil(influenceDistance / spacing[d]));
+                        extent[2 * d] = std::max((*structureExtent)[2 * d] - margin, 0);
+                        extent[2 * d + 1] = std::min((*structureExtent)[2 * d + 1] + margin, dimensions[d] - 1);
+                    }
+                    extent[4] = (*structureExtent)[4];
+                    extent[5] = (*structureExtent)[5];
+                }
+
+                std::vector<double> parameterValues = artifact.get().GetParameterValues();
+                std::size_t const parameterHash = Hash::Values(parameterValues);
+                ContributionKey key { parameterHash, std::move(parameterValues), &structure.get(),
+                                      StructureTree->GetMTime(), input, input->GetMTime(), Precision };
+                Contribution const* cachedContribution = nullptr;
+                Contribution* evaluatedContribution = nullptr;
+                uint64_t const contributionSizeInBytes = Contribution::GetSizeInBytes(extent);
+                if (auto contribution = contributionCache.Find(key); contribution && contribution->Extent == extent) {
+                    cachedContribution = contribution.get();
+                    cachedContributions.emplace_back(std::move(contribution));
+                } else if (evaluatedContributionsSizeInBytes + contributionSizeInBytes
+                                   <= contributionCache.GetMaxSizeInBytes()) {
+                    evaluatedContributionsSizeInBytes += contributionSizeInBytes;
+                    evaluatedContribution = evaluatedContributions.emplace_back(
+                            std::move(key), std::make_shared<Contribution>(extent)).second.get();
+                }
+
+                StructureSliceDistanceMap const* distanceMap = isBounded && !cachedContribution
+                        ? getDistanceMap(structure.get())
+                        : nullptr;
+
+                candidates.push_back({ artifactType, &artifact.get(), &structure.get(), maxStructureRadiodensity,
+                                       runs, distanceMap, extent, cachedContribution, evaluatedContribution });
             }
         }
-    });
+    }
 
-    auto addArtifactValues = [=](vtkIdType pointId, vtkIdType endPointId) {
-        for (; pointId < endPointId; pointId++) {
-            float const delta = motionValues[pointId] + metallicValues[pointId] + windmillValues[pointId];
-            radiodensities[pointId] += delta;
+    // tiles of whole slices, so that the candidates' slice state (structure runs, motion values) is set up once
+    Algorithm const algorithm { this, StructureTree, candidates, grid, radiodensities, artifactArrays, Precision };
+    ImageDataUtils::ForEachTile(grid, algorithm, dimensions[1]);
 
-            if (motionValues[pointId] > 0.0F && radiodensities[pointId] < -500.0F)
-                radiodensities[pointId] += 1000.0F;
-        }
-    };
-    vtkSMPTools::For(0, numberOfPoints, addArtifactValues);
+    if (!GetAbortOutput()) {
+        for (auto& [ key, contribution ] : evaluatedContributions)
+            contributionCache.Insert(key, std::move(contribution));
+    }
 
     if (GetErrorCode() != 0U)
         return 0;
@@ -184,43 +286,6 @@ auto StructureArtifactsFilter::GetArrayName(SubType subType) noexcept -> std::st
     return SubTypeToString(subType);
 }
 
-StructureArtifactsFilter::Algorithm::Algorithm(StructureArtifactsFilter* self,
-                                               CtStructureTree const* structureTree,
-                                               vtkImageData* volumeData,
-                                               CtStructureVariant const* structureVariant,
-                                               StructureArtifact const* structureArtifact,
-                                               float* radiodensities,
-                                               StructureId const* basicStructureIds,
-                                               float* const artifactValues) :
-        Self(self),
-        StructureTree(structureTree),
-        VolumeData(volumeData),
-        StructureVariant(structureVariant),
-        MaxStructureRadiodensity(StructureTree->GetMaxTissueValue(*structureVariant)),
-        StructureArtifact_(structureArtifact),
-        Spacing([this] {
-            std::array<double, 3> spacing {};
-            std::copy(VolumeData->GetSpacing(), std::next(VolumeData->GetSpacing(), 3), spacing.begin());
-            return spacing;
-        }()),
-        UpdateDims([this] {
-            std::array<int, 3> updateDims {};
-            std::copy(VolumeData->GetDimensions(), std::next(VolumeData->GetDimensions(), 3), updateDims.begin());
-            return updateDims;
-        }()),
-        StartPoint([this] {
-            DoublePoint startPoint;
-            VolumeData->GetPoint(0, startPoint.data());
-            return startPoint;
-        }()),
-        Radiodensities(radiodensities),
-        BasicStructureIds(basicStructureIds),
-        StructureArtifactIds(StructureTree->GetBasicStructureIds(*StructureVariant)),
-        ArtifactValues(artifactValues) {
-    std::copy(volumeData->GetSpacing(), std::next(volumeData->GetSpacing(), 3), Spacing.begin());
-    std::copy(volumeData->GetDimensions(), std::next(volumeData->GetDimensions(), 3), UpdateDims.begin());
-}
-
 //struct Calculate {
 //    DoublePoint const StartPoint;
 //    std::array<double, 3> const Spacing;
@@ -285,67 +350,106 @@ StructureArtifactsFilter::Algorithm::Algorithm(StructureArtifactsFilter* self,
 //    }
 //};
 
-void StructureArtifactsFilter::Algorithm::operator()(vtkIdType pointId, vtkIdType endPointId) const {
+void StructureArtifactsFilter::Algorithm::operator()(ImageDataUtils::Tile const& tile) const {
+    using RunIterator = std::span<StructureVoxelIndex::Run const>::iterator;
+
+    struct SliceCandidate {
+        ArtifactCandidate const* Candidate;
+        RunIterator Run; // first run of the structure not ending before the current voxel
+        RunIterator RunsEnd;
+        float const* MotionValues; // values of the whole slice for motion artifacts, nullptr otherwise
+    };
+
     Self->CheckAbort();
 
     if (Self->GetAbortOutput())
         return;
 
-    DoublePoint startPoint;
-    VolumeData->GetPoint(pointId, startPoint.data());
-
-    std::array<int, 3> const startPointCoordinates = PointIdToDimensionCoordinates(pointId, UpdateDims);
-    std::array<int, 3> const endPointCoordinates = PointIdToDimensionCoordinates(endPointId, UpdateDims);
-    auto [ x1, y1, z1 ] = startPointCoordinates;
-    auto lastValidPointCoordinates = GetDecrementedCoordinates(endPointCoordinates, UpdateDims);
-    auto [ x2, y2, z2 ] = lastValidPointCoordinates;
-
-    DoublePoint point = StartPoint;
-    point[0] += x1 * Spacing[0];
-    point[1] += y1 * Spacing[1];
-    point[2] += z1 * Spacing[2];
-
-    for (vtkIdType z = z1; z <= z2; z++) {
-        vtkIdType y = 0;
-        if (z == z1)
-            y = y1;
-
-        vtkIdType yEnd = UpdateDims[1] - 1;
-        if (z == z2)
-            yEnd = y2;
-
-        for (; y <= yEnd; y++) {
-            vtkIdType x = 0;
-            if (z == z1 && y == y1)
-                x = x1;
-
-            vtkIdType xEnd = UpdateDims[0] - 1;
-            if (z == z2 && y == y2)
-                xEnd = x2;
-
-            for (; x <= xEnd; x++) {
-                bool const pointOccupiedByStructure
-                        = std::ranges::any_of(StructureArtifactIds,
-                                              [&](StructureId id) { return id == BasicStructureIds[pointId]; });
-
-                ArtifactValues[pointId] += StructureArtifact_->EvaluateAtPosition(point,
-                                                                                  MaxStructureRadiodensity,
-                                                                                  pointOccupiedByStructure,
-                                                                                  *StructureTree,
-                                                                                  *StructureVariant,
-                                                                                  Spacing);
-
-                pointId++;
-
-                point[0] += Spacing[0];
-            }
-
-            point[0] = StartPoint[0];
-            point[1] += Spacing[1];
+    std::array<int, 3> const& dimensions = VoxelGrid.Dimensions;
+    std::array<double, 3> const& spacing = VoxelGrid.Spacing;
+    DoublePoint const& startPoint = VoxelGrid.StartPoint;
+
+    // the tile is a whole slice
+    vtkIdType const firstRowId = tile.RowBegin;
+    auto const z = static_cast<int>(firstRowId / dimensions[1]);
+    DoublePoint const sliceStartPoint { startPoint[0], startPoint[1], startPoint[2] + z * spacing[2] };
+
+    std::vector<SliceCandidate> sliceCandidates;
+    std::vector<std::vector<float>> motionSliceValues;
+    for (auto const& candidate : Candidates) {
+        if (z < candidate.Extent[4] || z > candidate.Extent[5])
+            continue;
+
+        auto const run = std::ranges::lower_bound(candidate.StructureRuns, firstRowId, {},
+                                                  &StructureVoxelIndex::Run::RowId);
+
+        float const* motionValues = nullptr;
+        auto const* motionArtifact = candidate.Artifact->GetSubTypeArtifact<MotionArtifact>();
+        if (motionArtifact && !candidate.CachedContribution) {
+            std::vector<float>& sliceValues = motionSliceValues.emplace_back(VoxelGrid.GetSliceSize());
+            motionArtifact->EvaluateSlice(sliceStartPoint, { dimensions[0], dimensions[1] },
+                                          *StructureTree, *candidate.Structure, spacing, Precision, sliceValues);
+            motionValues = sliceValues.data();
         }
 
-        point[0] = StartPoint[0];
-        point[1] = StartPoint[1];
-        point[2] += Spacing[2];
+        sliceCandidates.push_back({ &candidate, run, candidate.StructureRuns.end(), motionValues });
     }
+
+    tile.ForEachRow([&](ImageDataUtils::Row const& row) {
+        int const y = row.Y;
+        vtkIdType const rowId = firstRowId + y;
+        vtkIdType pointId = row.PointId;
+        DoublePoint point = row.StartPoint;
+
+        for (int x = 0; x < dimensions[0]; x++, pointId++, point[0] += spacing[0]) {
+            std::array<float, NumberOfSubTypes> values {};
+
+            for (auto& [ candidate, run, runsEnd, motionValues ] : sliceCandidates) {
+                while (run != runsEnd && (run->RowId < rowId || (run->RowId == rowId && run->XEnd <= x)))
+                    ++run;
+
+                if (run != runsEnd && run->RowId == rowId && run->XBegin <= x)
+                    continue;
+
+                if (auto const& extent = candidate->Extent;
+                        x < extent[0] || x > extent[1] || y < extent[2] || y > extent[3])
+                    continue;
+
+                if (auto const* cached = candidate->CachedContribution) {
+                    float const cachedValue = cached->Values[cached->GetIndex(x, y, z)];
+                    values[static_cast<int>(candidate->Type)] += cachedValue;
+                    continue;
+                }
+
+                float const value = motionValues
+                        ? motionValues[y * dimensions[0] + x]
+                        : candidate->Artifact->EvaluateAtPosition(
+                                point,
+                                candidate->MaxStructureRadiodensity,
+                                false,
+                                candidate->DistanceMap
+                                        ? candidate->DistanceMap->GetClosestPointOnXYPlane(pointId)
+                                        : std::nullopt,
+                                *StructureTree,
+                                *candidate->Structure,
+                                spacing,
+                                Precision);
+
+                if (auto* evaluated = candidate->EvaluatedContribution)
+                    evaluated->Values[evaluated->GetIndex(x, y, z)] = value;
+                values[static_cast<int>(candidate->Type)] += value;
+            }
+
+            float& radiodensity = Radiodensities[pointId];
+            radiodensity += std::accumulate(values.cbegin(), values.cend(), 0.0F);
+
+            if (values[static_cast<int>(SubType::MOTION)] > 0.0F && radiodensity < -500.0F)
+                radiodensity += 1000.0F;
+
+            for (int i = 0; i < NumberOfSubTypes; i++) {
+                if (ArtifactValues[i])
+                    ArtifactValues[i][pointId] = values[i];
+            }
+        }
+    });
 }
@@ -1,12 +1,20 @@
 #pragma once
 
 #include "StructureArtifact.h"
+#include "StructureArtifactContributionCache.h"
+#include "StructureVoxelIndex.h"
+#include "../../Modeling/CtStructureTreeProgram.h"
+#include "../../Utils/BrickSparseDataArray.h"
+#include "../../Utils/ImageDataUtils.h"
 #include "../../Utils/LinearAlgebraTypes.h"
 
 #include <vtkImageAlgorithm.h>
 
+#include <span>
+
 class CtStructureTree;
 class CtStructureVariant;
+class StructureSliceDistanceMap;
 class TreeStructureArtifactListCollection;
 
 
@@ -27,31 +35,53 @@ public:
     [[nodiscard]] auto
     GetStructureArtifactCollection() const -> TreeStructureArtifactListCollection*;
 
+    [[nodiscard]] auto
+    GetEvaluationPrecision() const noexcept -> EvaluationPrecision { return Precision; }
+
+    /** Sets the precision the structure functions are evaluated in when computing the artifacts */
+    auto
+    SetEvaluationPrecision(EvaluationPrecision precision) -> void;
+
+    [[nodiscard]] auto
+    GetOutputArtifactArrays() const noexcept -> bool { return OutputArtifactArrays; }
+
+    /** Sets whether the summed values of each artifact sub type are output as separate arrays, e.g. for debugging */
+    auto
+    SetOutputArtifactArrays(bool outputArtifactArrays) -> void;
+
+    static constexpr auto NumberOfSubTypes = StructureArtifactDetails::GetNumberOfSubTypeValues();
+
+    /** Artifact contributions below this radiodensity are treated as zero when bounding the artifacts' regions */
+    static constexpr float ContributionEpsilon = 0.01F;
+
+    /** A structure artifact together with the data of its structure needed to evaluate it */
+    struct ArtifactCandidate {
+        StructureArtifact::SubType Type;
+        StructureArtifact const* Artifact;
+        CtStructureVariant const* Structure;
+        float MaxStructureRadiodensity;
+        std::span<StructureVoxelIndex::Run const> StructureRuns;
+        StructureSliceDistanceMap const* DistanceMap; // nullptr for artifacts that do not need closest points
+        std::array<int, 6> Extent; // voxels { x1, x2, y1, y2, z1, z2 } the artifact may contribute to
+        StructureArtifactContributionCache::Contribution const* CachedContribution; // nullptr if not cached
+        StructureArtifactContributionCache::Contribution* EvaluatedContribution; // nullptr if cached or too large
+    };
+
+    /**
+     * Evaluates all artifact candidates in a single pass over the voxels of a tile of one whole slice.
+     * The contributions to a voxel are summed and added to its radiodensity once.
+     * Voxels of a candidate's structure receive no contribution from the candidate.
+     */
     struct Algorithm {
         StructureArtifactsFilter* Self;
         CtStructureTree const* StructureTree;
-        vtkImageData* VolumeData;
-        CtStructureVariant const* StructureVariant;
-        float MaxStructureRadiodensity;
-        StructureArtifact const* StructureArtifact_;
-        std::array<double, 3> Spacing;
-        std::array<int, 3> UpdateDims;
-        DoublePoint StartPoint;
+        std::span<ArtifactCandidate const> Candidates;
+        ImageDataUtils::Grid const& VoxelGrid;
         float* Radiodensities;
-        StructureId const* BasicStructureIds;
-        std::vector<StructureId> StructureArtifactIds;
-        float* const ArtifactValues;
-
-        Algorithm(StructureArtifactsFilter* self,
-                  CtStructureTree const* structureTree,
-                  vtkImageData* volumeData,
-                  CtStructureVariant const* structureVariant,
-                  StructureArtifact const* structureArtifact,
-                  float* radiodensities,
-                  StructureId const* basicStructureIds,
-                  float* artifactValues);
-
-        void operator()(vtkIdType pointId, vtkIdType endPointId) const;
+        std::array<float*, NumberOfSubTypes> ArtifactValues; // nullptr unless the artifact arrays are output
+        EvaluationPrecision Precision;
+
+        void operator()(ImageDataUtils::Tile const& tile) const;
     };
 
     void PrintSelf(ostream& os, vtkIndent indent) override;
@@ -80,4 +110,6 @@ private:
 
     TreeStructureArtifactListCollection* StructureArtifactCollection = nullptr;
     CtStructureTree const* StructureTree = nullptr;
+    EvaluationPrecision Precision = EvaluationPrecision::DOUBLE;
+    bool OutputArtifactArrays = false;
 };
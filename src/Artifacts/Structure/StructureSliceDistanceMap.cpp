@@ -0,0 +1,48 @@
+#include "StructureSliceDistanceMap.h"
+
+#include "../../Utils/DistanceTransform.h"
+
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <span>
+
+
+StructureSliceDistanceMap::StructureSliceDistanceMap(BrickSparseDataArray<StructureId> const& basicStructureIds,
+                                                     std::vector<StructureId> const& structureIds,
+                                                     DoublePoint const& startPoint,
+                                                     std::array<double, 3> const& spacing) :
+        Dimensions(basicStructureIds.GetDimensions()),
+        SliceSize(static_cast<vtkIdType>(Dimensions[0]) * Dimensions[1]),
+        StartPoint(startPoint),
+        Spacing(spacing),
+        ClosestFeatures(SliceSize * Dimensions[2]) {
+
+    auto isStructure = [&structureIds](StructureId id) { return std::ranges::find(structureIds, id) != structureIds.end(); };
+
+    vtkSMPTools::For(0, Dimensions[2], [&](vtkIdType z, vtkIdType endZ) {
+        std::vector<uint8_t> mask(SliceSize);
+
+        for (; z < endZ; z++) {
+            for (int y = 0; y < Dimensions[1]; y++) {
+                uint8_t* const rowMask = &mask[y * Dimensions[0]];
+
+                basicStructureIds.ForEachRowSegment(y, static_cast<int>(z), 0, Dimensions[0],
+                                                    [&](int x, int length, StructureId const* ids, StructureId uniformId) {
+                    if (!ids) {
+                        std::fill_n(std::next(rowMask, x), length, isStructure(uniformId));
+                        return;
+                    }
+
+                    for (int i = 0; i < length; i++)
+                        rowMask[x + i] = isStructure(ids[i]);
+                });
+            }
+
+            DistanceTransform::FeatureTransform2D(mask,
+                                                  { Dimensions[0], Dimensions[1] },
+                                                  { Spacing[0], Spacing[1] },
+                                                  std::span { ClosestFeatures }.subspan(z * SliceSize, SliceSize));
+        }
+    });
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../../Utils/BrickSparseDataArray.h"
+#include "../../Utils/IndexTypes.h"
+#include "../../Utils/LinearAlgebraTypes.h"
+
+#include <array>
+#include <optional>
+#include <vector>
+
+
+/**
+ * Closest voxel of a structure within the same z-slice, for every voxel of an image.
+ * The structure is rasterized from the basic structure ids of the image, and an exact 2D Euclidean feature transform
+ * is computed for each slice, in parallel across slices.
+ */
+class StructureSliceDistanceMap {
+public:
+    StructureSliceDistanceMap(BrickSparseDataArray<StructureId> const& basicStructureIds,
+                              std::vector<StructureId> const& structureIds,
+                              DoublePoint const& startPoint,
+                              std::array<double, 3> const& spacing);
+
+    /** Center of the closest structure voxel in the slice of the given point, nullopt if the slice is empty */
+    [[nodiscard]] auto
+    GetClosestPointOnXYPlane(vtkIdType pointId) const noexcept -> std::optional<DoublePoint> {
+        int32_t const feature = ClosestFeatures[pointId];
+        if (feature == -1)
+            return std::nullopt;
+
+        vtkIdType const z = pointId / SliceSize;
+        return DoublePoint { StartPoint[0] + (feature % Dimensions[0]) * Spacing[0],
+                             StartPoint[1] + (feature / Dimensions[0]) * Spacing[1],
+                             StartPoint[2] + static_cast<double>(z) * Spacing[2] };
+    }
+
+private:
+    std::array<int, 3> Dimensions;
+    vtkIdType SliceSize;
+    DoublePoint StartPoint;
+    std::array<double, 3> Spacing;
+    std::vector<int32_t> ClosestFeatures; // index within the slice
+};
@@ -0,0 +1,87 @@
+#include "StructureVoxelIndex.h"
+
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+
+
+StructureVoxelIndex::StructureVoxelIndex(BrickSparseDataArray<StructureId> const& basicStructureIds) :
+        Dimensions(basicStructureIds.GetDimensions()) {
+
+    std::vector<std::vector<std::pair<StructureId, Run>>> sliceRuns(Dimensions[2]);
+
+    vtkSMPTools::For(0, Dimensions[2], [&](vtkIdType z, vtkIdType endZ) {
+        for (; z < endZ; z++) {
+            auto& runs = sliceRuns[z];
+
+            for (int y = 0; y < Dimensions[1]; y++) {
+                vtkIdType const rowId = z * Dimensions[1] + y;
+
+                auto addRun = [&runs, rowId](StructureId id, int x, int length) {
+                    if (id == 0)
+                        return;
+
+                    if (!runs.empty()) {
+                        auto& [ lastId, lastRun ] = runs.back();
+                        if (lastId == id && lastRun.RowId == rowId && lastRun.XEnd == x) {
+                            lastRun.XEnd += length;
+                            return;
+                        }
+                    }
+
+                    runs.emplace_back(id, Run { rowId, x, x + length });
+                };
+
+                basicStructureIds.ForEachRowSegment(y, static_cast<int>(z), 0, Dimensions[0],
+                                                    [&](int x, int length, StructureId const* ids, StructureId uniformId) {
+                    if (!ids) {
+                        addRun(uniformId, x, length);
+                        return;
+                    }
+
+                    for (int i = 0; i < length; i++)
+                        addRun(ids[i], x + i, 1);
+                });
+            }
+        }
+    });
+
+    for (auto const& runs : sliceRuns) {
+        for (auto const& [ id, run ] : runs)
+            StructureRuns[id].emplace_back(run);
+    }
+}
+
+auto StructureVoxelIndex::GetRuns(std::vector<StructureId> const& structureIds) const -> std::vector<Run> {
+    std::vector<Run> runs;
+    for (StructureId const id : structureIds) {
+        if (auto const it = StructureRuns.find(id); it != StructureRuns.end())
+            runs.insert(runs.end(), it->second.cbegin(), it->second.cend());
+    }
+
+    if (structureIds.size() > 1) {
+        std::ranges::sort(runs, [](Run const& a, Run const& b) {
+            return a.RowId != b.RowId ? a.RowId < b.RowId : a.XBegin < b.XBegin;
+        });
+    }
+
+    return runs;
+}
+
+auto StructureVoxelIndex::GetExtent(std::vector<Run> const& runs) const noexcept -> std::optional<std::array<int, 6>> {
+    if (runs.empty())
+        return std::nullopt;
+
+    std::array<int, 6> extent { Dimensions[0], -1, Dimensions[1], -1,
+                                static_cast<int>(runs.front().RowId / Dimensions[1]),
+                                static_cast<int>(runs.back().RowId / Dimensions[1]) };
+    for (Run const& run : runs) {
+        int const y = static_cast<int>(run.RowId % Dimensions[1]);
+        extent[0] = std::min(extent[0], run.XBegin);
+        extent[1] = std::max(extent[1], run.XEnd - 1);
+        extent[2] = std::min(extent[2], y);
+        extent[3] = std::max(extent[3], y);
+    }
+
+    return extent;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../../Utils/BrickSparseDataArray.h"
+#include "../../Utils/IndexTypes.h"
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * Run-length index of the voxels of each basic structure, built once per input from its basic structure ids.
+ * Air (id 0) is not indexed.
+ */
+class StructureVoxelIndex {
+public:
+    struct Run {
+        vtkIdType RowId; // y + z * number of rows per slice
+        int XBegin;
+        int XEnd; // exclusive
+    };
+
+    explicit StructureVoxelIndex(BrickSparseDataArray<StructureId> const& basicStructureIds);
+
+    /** Runs of the voxels belonging to any of the given basic structures, sorted by row and x */
+    [[nodiscard]] auto
+    GetRuns(std::vector<StructureId> const& structureIds) const -> std::vector<Run>;
+
+    [[nodiscard]] auto
+    GetDimensions() const noexcept -> std::array<int, 3> { return Dimensions; }
+
+    /** Bounding extent { x1, x2, y1, y2, z1, z2 } of the voxels of the given runs, nullopt if there are none */
+    [[nodiscard]] auto
+    GetExtent(std::vector<Run> const& runs) const noexcept -> std::optional<std::array<int, 6>>;
+
+private:
+    std::array<int, 3> Dimensions;
+    std::unordered_map<StructureId, std::vector<Run>> StructureRuns;
+};
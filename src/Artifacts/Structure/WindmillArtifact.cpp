@@ -123,17 +123,18 @@ auto WindmillArtifact::SetLength(float length) noexcept -> void {
 auto WindmillArtifact::EvaluateAtPosition(DoublePoint const& point,
                                           float const maxRadiodensity,
                                           bool const pointOccupiedByStructure,
+                                          std::optional<DoublePoint> const& closestXYPoint,
                                           CtStructureTree const& structureTree,
                                           CtStructureVariant const& structure,
-                                          std::array<double, 3> const& spacing) const noexcept -> float {
+                                          std::array<double, 3> const& spacing,
+                                          EvaluationPrecision precision) const noexcept -> float {
     if (pointOccupiedByStructure || maxRadiodensity < 0.0F)
         return 0.0F;
 
-    auto const closestXYPoint = structureTree.ClosestPointOnXYPlane(point, structure);
     if (!closestXYPoint || point == *closestXYPoint)
         return 0.0F;
 
-    if (auto const radiodensity = structureTree.FunctionValueAndRadiodensity(point, &structure).Radiodensity;
+    if (auto const radiodensity = structureTree.FunctionValueAndRadiodensity(point, &structure, precision).Radiodensity;
         radiodensity <= 0.0F)
         return 0.0F;
 
@@ -152,6 +153,19 @@ auto WindmillArtifact::EvaluateAtPosition(DoublePoint const& point,
     return maxRadiodensity * distanceFactor * directionFactor * RadiodensityFactor;
 }
 
+auto WindmillArtifact::GetInfluenceDistance(float maxRadiodensity, float epsilon) const noexcept -> float {
+    float const maxContribution = maxRadiodensity * std::abs(RadiodensityFactor);
+    if (maxContribution <= epsilon)
+        return 0.0F;
+
+    // the contributions fall off linearly with the distance and vanish at Length
+    return Length * (1.0F - epsilon / maxContribution);
+}
+
+auto WindmillArtifact::GetParameterValues() const -> std::vector<double> {
+    return { RadiodensityFactor, AngularWidth, RotationPerSlice, Length };
+}
+
 auto WindmillArtifact::GetProperties() noexcept -> PipelineParameterProperties {
     PipelineParameterProperties properties;
     properties.Add(
@@ -9,9 +9,12 @@
 #include <vtkTransform.h>
 
 #include <array>
+#include <optional>
+#include <vector>
 
 class CtStructureTree;
 class CtStructureVariant;
+enum struct EvaluationPrecision : uint8_t;
 
 struct WindmillArtifactData;
 
@@ -53,17 +56,30 @@ public:
     auto
     SetLength(float length) noexcept -> void;
 
+    /**
+     * In-plane distance from the structure beyond which all contributions of the artifact are below epsilon,
+     * 0 if there are none above it
+     */
+    [[nodiscard]] auto
+    GetInfluenceDistance(float maxRadiodensity, float epsilon) const noexcept -> float;
+
     [[nodiscard]] auto
     EvaluateAtPosition(DoublePoint const& point,
                        float maxRadiodensity,
                        bool pointOccupiedByStructure,
+                       std::optional<DoublePoint> const& closestXYPoint,
                        CtStructureTree const& structureTree,
                        CtStructureVariant const& structure,
-                       std::array<double, 3> const& spacing) const noexcept -> float;
+                       std::array<double, 3> const& spacing,
+                       EvaluationPrecision precision) const noexcept -> float;
 
     [[nodiscard]] auto
     GetProperties() noexcept -> PipelineParameterProperties;
 
+    /** The parameters that determine the artifact's values */
+    [[nodiscard]] auto
+    GetParameterValues() const -> std::vector<double>;
+
     [[nodiscard]] auto
     GetMTime() const noexcept -> vtkMTimeType { return MTime; }
 
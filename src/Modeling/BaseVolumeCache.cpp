@@ -0,0 +1,37 @@
+#include "BaseVolumeCache.h"
+
+#include "CtDataSource.h"
+
+#include <vtkImageData.h>
+#include <vtkTrivialProducer.h>
+
+BaseVolumeCache::BaseVolumeCache() = default;
+
+BaseVolumeCache::~BaseVolumeCache() = default;
+
+auto BaseVolumeCache::GetOutputPort(CtDataSource& dataSource) -> vtkAlgorithmOutput* {
+    Update(dataSource);
+
+    return Producer->GetOutputPort();
+}
+
+auto BaseVolumeCache::Clear() -> void {
+    Producer->SetOutput(vtkNew<vtkImageData>());
+    DataSource = nullptr;
+    DataSourceMTime = 0;
+}
+
+auto BaseVolumeCache::Update(CtDataSource& dataSource) -> void {
+    if (DataSource == &dataSource && dataSource.GetMTime() == DataSourceMTime)
+        return;
+
+    dataSource.UpdateWholeExtent();
+
+    // a new image object, so that pipelines still holding the previous snapshot are not affected
+    vtkNew<vtkImageData> volume;
+    volume->ShallowCopy(dataSource.GetOutput());
+    Producer->SetOutput(volume);
+
+    DataSource = &dataSource;
+    DataSourceMTime = dataSource.GetMTime();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vtkNew.h>
+#include <vtkType.h>
+#include <vtkWeakPointer.h>
+
+class CtDataSource;
+
+class vtkAlgorithmOutput;
+class vtkTrivialProducer;
+
+
+/**
+ * Read-only snapshot of the volume of a CT data source, shared by all pipelines and parameter space states that
+ * generate images from it. The snapshot is only regenerated when the data source or its MTime changes.
+ * Its arrays are shared by reference: consumers must copy the arrays they modify instead of writing to them.
+ */
+class BaseVolumeCache {
+public:
+    BaseVolumeCache();
+    ~BaseVolumeCache();
+
+    /** Output port providing the snapshot of the given data source, updated if it is stale */
+    [[nodiscard]] auto
+    GetOutputPort(CtDataSource& dataSource) -> vtkAlgorithmOutput*;
+
+    /** Releases the snapshot, e.g. once all images have been generated */
+    auto
+    Clear() -> void;
+
+private:
+    auto
+    Update(CtDataSource& dataSource) -> void;
+
+    vtkNew<vtkTrivialProducer> Producer;
+    vtkWeakPointer<CtDataSource> DataSource;
+    vtkMTimeType DataSourceMTime = 0;
+};
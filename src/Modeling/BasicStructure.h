@@ -166,7 +166,7 @@ public:
     operator==(const BasicStructure& other) const -> bool { return Id == other.Id && Tissue == other.Tissue; }
 
 private:
-    friend struct EvaluateImplicitStructures;
+    friend class CtStructureTreeProgram;
     friend class BasicStructureDetails::BasicStructureDataImpl;
 
     StructureId Id = ++GlobalBasicStructureId;
@@ -26,6 +26,16 @@ auto Sphere::SetFunctionData(const Data& data) const noexcept -> void {
     Function->SetCenter(data.Center.data());
 }
 
+auto Sphere::EvaluateFunctionBatch(FloatPoint const& start,
+                                   FloatVector const& step,
+                                   std::span<float> values) const noexcept -> void {
+    ShapeKernels::SphereKernel<float> const kernel { DoubleToFloatPoint({ Function->GetCenter()[0],
+                                                                          Function->GetCenter()[1],
+                                                                          Function->GetCenter()[2] }),
+                                                     static_cast<float>(Function->GetRadius()) };
+    ShapeKernels::EvaluateRow(kernel, start, step, values);
+}
+
 SphereWidget::SphereWidget() :
         RadiusSpinBox(new QDoubleSpinBox()),
         CenterCoordinateRow(new DoubleCoordinateRowWidget({ -100.0, 100.0, 1.0, 0.0 })) {
@@ -76,6 +86,18 @@ auto Box::SetFunctionData(Data const& data) const noexcept -> void {
     Function->SetXMax(maxPoint.data());
 }
 
+auto Box::EvaluateFunctionBatch(FloatPoint const& start,
+                                FloatVector const& step,
+                                std::span<float> values) const noexcept -> void {
+    DoublePoint minPoint {};
+    DoublePoint maxPoint {};
+    Function->GetXMin(minPoint.data());
+    Function->GetXMax(maxPoint.data());
+
+    ShapeKernels::BoxKernel<float> const kernel { DoubleToFloatPoint(minPoint), DoubleToFloatPoint(maxPoint) };
+    ShapeKernels::EvaluateRow(kernel, start, step, values);
+}
+
 BoxWidget::BoxWidget() :
         MinMaxPointWidget(new DoubleCoordinateRowWidget(true)) {
 
@@ -165,6 +187,15 @@ auto Cone::SetFunctionData(Data const& data) const noexcept -> void {
     BasePlane->SetOrigin(0.0, 0.0, data.Height);
 }
 
+auto Cone::EvaluateFunctionBatch(FloatPoint const& start,
+                                 FloatVector const& step,
+                                 std::span<float> values) const noexcept -> void {
+    ShapeKernels::ConeKernel<float> const kernel { static_cast<float>(UnboundedCone->GetAngleTangent()),
+                                                   static_cast<float>(TipPlane->GetOrigin()[2]),
+                                                   static_cast<float>(BasePlane->GetOrigin()[2]) };
+    ShapeKernels::EvaluateRow(kernel, start, step, values);
+}
+
 
 
 auto CylinderData::PopulateFromWidget(Widget const* widget) noexcept -> void {
@@ -231,3 +262,13 @@ auto Cylinder::SetFunctionData(Data const& data) const noexcept -> void {
     UnboundedCylinder->SetRadius(data.Radius);
     TopPlane->GetOrigin()[2] = data.Height;
 }
+
+auto Cylinder::EvaluateFunctionBatch(FloatPoint const& start,
+                                     FloatVector const& step,
+                                     std::span<float> values) const noexcept -> void {
+    ShapeKernels::CylinderKernel<float> const kernel { static_cast<float>(UnboundedCylinder->GetRadius()),
+                                                       static_cast<float>(BottomPlane->GetOrigin()[2]),
+                                                       static_cast<float>(TopPlane->GetOrigin()[2]) };
+    ShapeKernels::EvaluateRow(kernel, start, step, values);
+}
+
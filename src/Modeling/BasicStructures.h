@@ -2,6 +2,7 @@
 
 #include "CtStructure.h"
 #include "ImplicitCone.h"
+#include "ShapeKernels.h"
 #include "../Artifacts/Types.h"
 
 #include <vtkBox.h>
@@ -22,6 +23,7 @@ concept Evaluable = requires(T structure, typename T::Data data) {
     structure.AddFunctionData(data);
     structure.SetFunctionData(data);
     { structure.EvaluateFunction(Point{}) } -> std::same_as<float>;
+    structure.EvaluateFunctionBatch(FloatPoint{}, FloatVector{}, std::span<float>{});
 };
 
 template<typename T>
@@ -93,6 +95,9 @@ struct Sphere {
         return static_cast<float>(Function->EvaluateFunction(point.data()));
     }
 
+    auto
+    EvaluateFunctionBatch(FloatPoint const& start, FloatVector const& step, std::span<float> values) const noexcept -> void;
+
     [[nodiscard]] auto
     ClosestPointOnXYPlane(Point const& point) const -> std::optional<DoublePoint> {
         double const radius3d = Function->GetRadius();
@@ -118,6 +123,8 @@ struct Sphere {
     operator==(const Sphere& other) const noexcept -> bool { return Function == other.Function; }
 
 private:
+    friend class CtStructureTreeProgram;
+
     vtkNew<vtkSphere> Function;
 };
 
@@ -160,6 +167,9 @@ struct Box {
         return static_cast<float>(Function->EvaluateFunction(point.data()));
     }
 
+    auto
+    EvaluateFunctionBatch(FloatPoint const& start, FloatVector const& step, std::span<float> values) const noexcept -> void;
+
     [[nodiscard]] auto
     ClosestPointOnXYPlane(Point const& point) const -> std::optional<DoublePoint> {
         double const* bounds = Function->GetBounds();
@@ -180,6 +190,8 @@ struct Box {
     operator==(const Box& other) const noexcept -> bool { return Function == other.Function; }
 
 private:
+    friend class CtStructureTreeProgram;
+
     vtkNew<vtkBox> Function;
 };
 
@@ -253,6 +265,9 @@ struct Cone {
         return static_cast<float>(ConeFunction->EvaluateFunction(point.data()));
     }
 
+    auto
+    EvaluateFunctionBatch(FloatPoint const& start, FloatVector const& step, std::span<float> values) const noexcept -> void;
+
     [[nodiscard]] auto
     ClosestPointOnXYPlane(Point const& point) const -> std::optional<DoublePoint> {
         double const angleRad = vtkMath::RadiansFromDegrees(UnboundedCone->GetAngle());
@@ -277,6 +292,8 @@ struct Cone {
     [[nodiscard]] auto
     operator==(Cone const& other) const noexcept -> bool { return ConeFunction == other.ConeFunction; }
 private:
+    friend class CtStructureTreeProgram;
+
     vtkNew<ImplicitCone> UnboundedCone;
     vtkNew<vtkPlane> TipPlane;
     vtkNew<vtkPlane> BasePlane;
@@ -337,6 +354,9 @@ struct Cylinder {
         return static_cast<float>(CylinderFunction->EvaluateFunction(point.data()));
     }
 
+    auto
+    EvaluateFunctionBatch(FloatPoint const& start, FloatVector const& step, std::span<float> values) const noexcept -> void;
+
     [[nodiscard]] auto
     ClosestPointOnXYPlane(Point const& point) const -> std::optional<DoublePoint> {
         double const radius = UnboundedCylinder->GetRadius();
@@ -352,6 +372,8 @@ struct Cylinder {
     [[nodiscard]] auto
     operator==(Cylinder const& other) const noexcept -> bool { return CylinderFunction == other.CylinderFunction; }
 private:
+    friend class CtStructureTreeProgram;
+
     vtkNew<vtkCylinder> UnboundedCylinder;
     vtkNew<vtkPlane> BottomPlane;
     vtkNew<vtkPlane> TopPlane;
@@ -99,14 +99,13 @@ public:
     StructureCount() const noexcept -> uidx_t;
 
 private:
-    friend struct EvaluateImplicitStructures;
-    friend struct EvaluateFunctionValue;
     friend struct AddBasicStructureIndices;
     friend struct MaxTissueValueAlgorithm;
     friend struct FindClosestPointOnXYPlane;
     friend struct CombinedStructureDetails::CombinedStructureDataImpl;
     friend class CtStructureTree;
     friend class CtStructureTreeModel;
+    friend class CtStructureTreeProgram;
 
     [[nodiscard]] auto
     GetChildIndices() const noexcept -> const std::vector<uidx_t>&;
@@ -80,10 +80,11 @@ auto CtDataSource::RequestInformation(vtkInformation* vtkNotUsed(request),
 }
 
 auto CtDataSource::GetSpacing() const -> std::array<double, 3> {
+    std::array<int, 3> const numberOfVoxels = GetSampledNumberOfVoxels();
     std::array<double, 3> spacing {};
 
     for (int i = 0; i < spacing.size(); ++i) {
-        spacing[i] = PhysicalDimensions[i] / static_cast<double>(NumberOfVoxels[i]);
+        spacing[i] = PhysicalDimensions[i] / static_cast<double>(numberOfVoxels[i]);
     }
 
     return spacing;
@@ -100,16 +101,21 @@ auto CtDataSource::GetOrigin() const -> std::array<double, 3> {
 }
 
 auto CtDataSource::GetWholeExtent() const -> std::array<int, 6> {
+    std::array<int, 3> const numberOfVoxels = GetSampledNumberOfVoxels();
     std::array<int, 6> extent {};
     std::fill(extent.begin(), extent.end(), 0);
 
-    for (int i = 0; i < NumberOfVoxels.size(); ++i) {
-        extent[2 * i + 1] = NumberOfVoxels[i];
+    for (int i = 0; i < numberOfVoxels.size(); ++i) {
+        extent[2 * i + 1] = numberOfVoxels[i];
     }
 
     return extent;
 }
 
+auto CtDataSource::GetSampledNumberOfVoxels() const -> std::array<int, 3> {
+    return NumberOfVoxels;
+}
+
 auto CtDataSource::GetDimensions() const -> std::array<int, 3> {
     auto const extent = GetWholeExtent();
 
@@ -45,6 +45,12 @@ protected:
 
     std::array<int, 3> GetDimensions() const;
 
+    /**
+     * Number of voxels along each axis the volume is actually sampled with. Equal to the set number of voxels by
+     * default.
+     */
+    virtual std::array<int, 3> GetSampledNumberOfVoxels() const;
+
 
     FloatVector PhysicalDimensions {};
     std::array<int, 3> NumberOfVoxels {};
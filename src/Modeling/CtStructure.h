@@ -57,6 +57,7 @@ private:
     template<TStructureData StructureData> friend class CtStructureBaseData;
     friend class CtStructureTree;
     friend class CtStructureTreeModel;
+    friend class CtStructureTreeProgram;
 
     SimpleTransform Transform;
     std::string Name;
@@ -6,11 +6,11 @@
 #include "CombinedStructure.h"
 
 auto CtStructureTree::GetMTime() const -> vtkMTimeType {
-    vtkMTimeType const nodeMTime = HasRoot()
-            ? std::visit([](auto const& root) { return root.GetMTime(); }, Structures[*RootIdx])
-            : 0;
+    vtkMTimeType mTime = MTime.GetMTime();
+    for (auto const& structure : Structures)
+        mTime = std::max(mTime, std::visit([](auto const& node) { return node.GetMTime(); }, structure));
 
-    return std::max(MTime.GetMTime(), nodeMTime);
+    return mTime;
 }
 
 void CtStructureTree::AddBasicStructure(BasicStructure&& basicStructure, CombinedStructure* parent) {
@@ -22,9 +22,8 @@ void CtStructureTree::AddBasicStructure(BasicStructure&& basicStructure, Combine
         basicStructure.ParentIdx = std::nullopt;
         Structures.emplace_back(std::move(basicStructure));
         RootIdx = 0;
+        RecordModification({}, 0);
         EmitEvent({ CtStructureTreeEventType::ADD, 0 });
-
-        MTime.Modified();
         return;
     }
 
@@ -34,6 +33,7 @@ void CtStructureTree::AddBasicStructure(BasicStructure&& basicStructure, Combine
 
     uidx_t const parentIdx = FindIndexOf(*parent);
     uidx_t const insertionIdx = parentIdx + 1;
+    BoundingBox const oldBounds = GetStructureBounds(parentIdx);
 
     IncrementParentAndChildIndices(insertionIdx);
 
@@ -42,6 +42,7 @@ void CtStructureTree::AddBasicStructure(BasicStructure&& basicStructure, Combine
     basicStructure.ParentIdx = parentIdx;
     Structures.emplace(std::next(Structures.begin(), insertionIdx), std::move(basicStructure));
 
+    RecordModification(oldBounds, parentIdx);
     EmitEvent({ CtStructureTreeEventType::ADD, insertionIdx });
 }
 
@@ -61,6 +62,7 @@ void CtStructureTree::CombineWithBasicStructure(BasicStructure&& basicStructure,
 
     constexpr uidx_t combinedInsertionIdx = 0;
     constexpr uidx_t basicInsertionIdx = 1;
+    BoundingBox const oldBounds = GetStructureBounds(*RootIdx);
 
     IncrementParentAndChildIndices(combinedInsertionIdx);
     IncrementParentAndChildIndices(basicInsertionIdx);
@@ -80,7 +82,9 @@ void CtStructureTree::CombineWithBasicStructure(BasicStructure&& basicStructure,
     Structures.emplace(std::next(Structures.begin(), basicInsertionIdx),
                        std::move(basicStructure));
 
+    RecordModification(oldBounds, newRootIdx);
     EmitEvent({ CtStructureTreeEventType::ADD, combinedInsertionIdx });
+    RecordModification({}, std::nullopt);
     EmitEvent({ CtStructureTreeEventType::ADD, basicInsertionIdx });
 }
 
@@ -109,6 +113,7 @@ auto CtStructureTree::RefineWithBasicStructure(BasicStructure&& basicStructure,
     uidx_t const combinedInsertionIdx = structureToRefineIdx;
     uidx_t const basicInsertionIdx = combinedInsertionIdx + 1;
     uidx_t const newRefinedIdx = combinedInsertionIdx + 2;
+    BoundingBox const oldBounds = GetStructureBounds(structureToRefineIdx);
 
     IncrementParentAndChildIndices(combinedInsertionIdx);
     IncrementParentAndChildIndices(basicInsertionIdx);
@@ -123,16 +128,16 @@ auto CtStructureTree::RefineWithBasicStructure(BasicStructure&& basicStructure,
     Structures.emplace(std::next(Structures.begin(), combinedInsertionIdx), std::move(combinedStructure));
     Structures.emplace(std::next(Structures.begin(), basicInsertionIdx), std::move(basicStructure));
 
-    EmitEvent({ CtStructureTreeEventType::ADD, combinedInsertionIdx });
-    EmitEvent({ CtStructureTreeEventType::ADD, basicInsertionIdx });
-
-    if (!parentIdx) {
+    if (parentIdx) {
+        auto& parent = std::get<CombinedStructure>(Structures[*parentIdx]);
+        parent.ReplaceChild(newRefinedIdx, combinedInsertionIdx);
+    } else
         RootIdx = 0;
-        return;
-    }
 
-    auto& parent = std::get<CombinedStructure>(Structures[*parentIdx]);
-    parent.ReplaceChild(newRefinedIdx, combinedInsertionIdx);
+    RecordModification(oldBounds, combinedInsertionIdx);
+    EmitEvent({ CtStructureTreeEventType::ADD, combinedInsertionIdx });
+    RecordModification({}, std::nullopt);
+    EmitEvent({ CtStructureTreeEventType::ADD, basicInsertionIdx });
 }
 
 void CtStructureTree::RefineWithBasicStructure(BasicStructureData const& newStructureData,
@@ -154,8 +159,10 @@ void CtStructureTree::RemoveBasicStructure(uidx_t removeIdx) {
     auto const& structure = std::get<BasicStructure>(GetStructureAt(removeIdx));
 
     if (RootIdx == removeIdx) {
+        BoundingBox const oldBounds = GetStructureBounds(removeIdx);
         Structures.erase(Structures.begin());
         RootIdx = std::nullopt;
+        RecordModification(oldBounds, std::nullopt);
         EmitEvent({ CtStructureTreeEventType::REMOVE, removeIdx });
         return;
     }
@@ -166,15 +173,18 @@ void CtStructureTree::RemoveBasicStructure(uidx_t removeIdx) {
 
     uidx_t const parentIdx = *parentIdxOptional;
     auto& parent = std::get<CombinedStructure>(Structures[parentIdx]);
+    BoundingBox const oldBounds = GetStructureBounds(parentIdx);
 
     parent.RemoveStructureIndex(removeIdx);
     Structures.erase(std::next(Structures.begin(), removeIdx));
     DecrementParentAndChildIndices(removeIdx);
+    RecordModification(oldBounds, parentIdx);
     EmitEvent({ CtStructureTreeEventType::REMOVE, removeIdx });
 
     if (parent.StructureCount() == 1) {
         const idx_t grandParentIdx = GetParentIdxOf(parent);
         const uidx_t remainingIdx = parent.StructureIdxAt(0);
+        BoundingBox const oldParentBounds = GetStructureBounds(parentIdx);
 
         if (grandParentIdx) {
             auto& grandParent = std::get<CombinedStructure>(Structures[*grandParentIdx]);
@@ -187,119 +197,43 @@ void CtStructureTree::RemoveBasicStructure(uidx_t removeIdx) {
                    Structures[remainingIdx]);
         Structures.erase(std::next(Structures.begin(), parentIdx));
         DecrementParentAndChildIndices(parentIdx);
+        RecordModification(oldParentBounds, static_cast<uidx_t>(remainingIdx - 1));
         EmitEvent({ CtStructureTreeEventType::REMOVE, static_cast<uidx_t>(parentIdx) });
     }
-
-    MTime.Modified();
 }
 
-struct EvaluateImplicitStructures {
-    using ModelingResult = CtStructureTree::ModelingResult;
-
-    auto operator() (const BasicStructure& basicStructure) const noexcept -> ModelingResult {
-        return { basicStructure.FunctionValue(basicStructure.GetTransformedPoint(point)),
-                 basicStructure.Tissue.Radiodensity,
-                 basicStructure.Id };
-    }
-
-    auto operator() (const CombinedStructure& combinedStructure) const noexcept -> ModelingResult {
-        const Point transformedPoint = combinedStructure.GetTransformedPoint(point);
+auto CtStructureTree::GetProgram() const -> std::shared_ptr<CtStructureTreeProgram const> {
+    vtkMTimeType const mTime = GetMTime();
+    if (ProgramMTime.load(std::memory_order_acquire) >= mTime)
+        return Program.load(std::memory_order_acquire);
 
-        std::vector<ModelingResult> evals;
-        const std::vector<uidx_t>& childIndices = combinedStructure.GetChildIndices();
-        evals.reserve(childIndices.size());
-        for (const auto childIdx : childIndices) {
-            evals.emplace_back(std::visit(EvaluateImplicitStructures{ structures, transformedPoint},
-                                          structures[childIdx]));
-        }
-
-        static constexpr auto compareModelingResults
-                = [](ModelingResult const& a, ModelingResult const& b) {
-            return a.FunctionValue < b.FunctionValue;
-        };
+    std::scoped_lock const lock { ProgramMutex };
 
-        switch (combinedStructure.Operator) {
-            case CombinedStructure::OperatorType::UNION:
-                return *std::ranges::min_element(evals, compareModelingResults);
-
-            case CombinedStructure::OperatorType::INTERSECTION:
-                return *std::ranges::max_element(evals, compareModelingResults);
-
-            case CombinedStructure::OperatorType::DIFFERENCE_: {
-                ModelingResult result = std::reduce(std::next(evals.begin()), evals.end(),
-                                                    evals[0],
-                                                    [](ModelingResult const res, ModelingResult const eval) {
-                    return ModelingResult { res.FunctionValue - eval.FunctionValue,
-                                            eval.FunctionValue < 0.0F
-                                                    ? res.Radiodensity - eval.Radiodensity
-                                                    : res.Radiodensity,
-                                            res.BasicCtStructureId };
-                });
-
-                if (result.Radiodensity == 0.0F)
-                    result.BasicCtStructureId = -1;
-
-                return result;
-            }
-
-            default: return {};
-        }
+    // holders of the previous snapshot keep it alive until they are done
+    if (ProgramMTime.load(std::memory_order_relaxed) < mTime) {
+        Program.store(std::make_shared<CtStructureTreeProgram const>(Structures, RootIdx), std::memory_order_release);
+        ProgramMTime.store(mTime, std::memory_order_release);
     }
 
-    const std::vector<CtStructureVariant>& structures;
-    const Point& point;
-};
+    return Program.load(std::memory_order_acquire);
+}
 
 auto CtStructureTree::FunctionValueAndRadiodensity(Point point,
-                                                   CtStructureVariant const* structure) const -> ModelingResult {
-    if (!HasRoot() || (structure && !std::visit([&](auto const& s) { return CtStructureExists(s); }, *structure)))
+                                                   CtStructureVariant const* structure,
+                                                   EvaluationPrecision precision) const -> ModelingResult {
+    if (!HasRoot())
         throw std::runtime_error("TreeArtifacts does not contain structure. Cannot evaluate");
 
-    if (structure)
-        point = TransformPointUntilStructure(point, *structure);
-
-    return std::visit(EvaluateImplicitStructures { Structures, point }, structure ? *structure : GetRoot());
+    std::shared_ptr<CtStructureTreeProgram const> const program = GetProgram();
+    return structure
+            ? program->Evaluate(point, IndexOfStoredStructure(*structure), precision)
+            : program->Evaluate(point, precision);
 }
 
-struct EvaluateFunctionValue {
-    auto operator() (BasicStructure const& basicStructure) const noexcept -> float {
-        return basicStructure.FunctionValue(basicStructure.GetTransformedPoint(point));
-    }
-
-    auto operator() (CombinedStructure const& combinedStructure) const noexcept -> float {
-        const Point transformedPoint = combinedStructure.GetTransformedPoint(point);
-
-        std::vector<float> results;
-        std::vector<uidx_t> const& childIndices = combinedStructure.GetChildIndices();
-        results.reserve(childIndices.size());
-        for (const auto childIdx : childIndices)
-            results.emplace_back(std::visit(EvaluateFunctionValue{structures, transformedPoint}, structures[childIdx]));
-
-        switch (combinedStructure.Operator) {
-            case CombinedStructure::OperatorType::UNION:
-                return *std::ranges::min_element(results);
-
-            case CombinedStructure::OperatorType::INTERSECTION:
-                return *std::ranges::max_element(results);
-
-            case CombinedStructure::OperatorType::DIFFERENCE_: {
-                return std::reduce(std::next(results.begin()), results.end(),
-                                   results[0],
-                                   std::minus{});
-            }
-
-            default: return {};
-        }
-    }
-
-    const std::vector<CtStructureVariant>& structures;
-    const Point& point;
-};
-
-auto CtStructureTree::FunctionValue(Point point, CtStructureVariant const& structure) const -> float {
-    point = TransformPointUntilStructure(point, structure);
-
-    return std::visit(EvaluateFunctionValue{Structures, point}, structure);
+auto CtStructureTree::FunctionValue(Point point,
+                                    CtStructureVariant const& structure,
+                                    EvaluationPrecision precision) const -> float {
+    return GetProgram()->Evaluate(point, IndexOfStoredStructure(structure), precision).FunctionValue;
 }
 
 struct FindClosestPointOnXYPlane {
@@ -380,6 +314,7 @@ void CtStructureTree::SetData(uidx_t structureIdx, QVariant const& data) {
         throw std::runtime_error("Cannot set data. Given structure idx does not exist.");
 
     CtStructureVariant& structureVariant = Structures[structureIdx];
+    BoundingBox const oldBounds = GetStructureBounds(structureIdx);
 
     if (data.canConvert<CombinedStructureData>()) {
         auto const combinedData = data.value<CombinedStructureData>();
@@ -389,6 +324,7 @@ void CtStructureTree::SetData(uidx_t structureIdx, QVariant const& data) {
         basicData.PopulateStructure(std::get<BasicStructure>(structureVariant));
     }
 
+    RecordModification(oldBounds, structureIdx);
     EmitEvent({ CtStructureTreeEventType::EDIT, structureIdx });
 }
 
@@ -496,9 +432,64 @@ auto CtStructureTree::StructureIdxExists(uidx_t idx) const noexcept -> bool {
     return idx < Structures.size();
 }
 
+auto CtStructureTree::IndexOfStoredStructure(CtStructureVariant const& structure) const -> uidx_t {
+    auto const* const first = Structures.data();
+    auto const* const last = std::next(first, static_cast<std::ptrdiff_t>(Structures.size()));
+
+    if (std::less {}(&structure, first) || !std::less {}(&structure, last))
+        throw std::runtime_error("TreeArtifacts does not contain structure. Cannot evaluate");
+
+    return static_cast<uidx_t>(std::distance(first, &structure));
+}
+
+auto CtStructureTree::GetModifiedRegionSince(vtkMTimeType mTime) const -> std::optional<BoundingBox> {
+    vtkMTimeType const treeMTime = GetMTime();
+    if (mTime >= treeMTime)
+        return BoundingBox {};
+
+    if (treeMTime > ModifiedRegionsMTime || mTime < ModifiedRegionsStartMTime)
+        return std::nullopt;
+
+    BoundingBox region {};
+    for (auto const& [ regionMTime, bounds ] : ModifiedRegions) {
+        if (regionMTime > mTime)
+            region.Extend(bounds);
+    }
+
+    return region;
+}
+
+auto CtStructureTree::GetStructureBounds(uidx_t structureIdx) const -> BoundingBox {
+    return CtStructureTreeProgram::ComputeStructureBounds(Structures, structureIdx);
+}
+
+auto CtStructureTree::RecordModification(BoundingBox const& oldBounds, std::optional<uidx_t> newStructureIdx) -> void {
+    BoundingBox region = oldBounds;
+
+    // the program is only rebuilt lazily once the tree MTime has been updated, so the subtree bounds are computed here
+    if (newStructureIdx)
+        region.Extend(GetStructureBounds(*newStructureIdx));
+
+    PendingModifiedRegion = region;
+}
+
 auto CtStructureTree::EmitEvent(CtStructureTreeEvent event) noexcept -> void {
     MTime.Modified();
 
+    vtkMTimeType const treeMTime = GetMTime();
+    if (PendingModifiedRegion) {
+        ModifiedRegions.push_back({ treeMTime, *PendingModifiedRegion });
+        if (ModifiedRegions.size() > MaxNumberOfModifiedRegions) {
+            ModifiedRegionsStartMTime = ModifiedRegions.front().MTime;
+            ModifiedRegions.pop_front();
+        }
+    } else {
+        ModifiedRegions.clear();
+        ModifiedRegionsStartMTime = treeMTime;
+    }
+    PendingModifiedRegion = std::nullopt;
+    ModifiedRegionsMTime = treeMTime;
+
     for (const auto& callback: TreeEventCallbacks)
         callback(event);
 }
@@ -2,9 +2,14 @@
 
 #include "BasicStructure.h"
 #include "CombinedStructure.h"
+#include "CtStructureTreeProgram.h"
 
 #include <vtkTimeStamp.h>
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <variant>
 #include <vector>
 
@@ -32,6 +37,10 @@ class CtStructureVariant : public std::variant<BasicStructure, CombinedStructure
 class CtStructureTree {
 public:
 
+    /**
+     * Latest modification of the tree or of any of its structures, whose transforms can also be modified directly.
+     * The compiled program, including its cached ancestor transforms, is rebuilt whenever it increases.
+     */
     [[nodiscard]] auto
     GetMTime() const -> vtkMTimeType;
 
@@ -81,17 +90,24 @@ public:
     [[nodiscard]] auto
     StructureCount() const noexcept -> uidx_t;
 
-    struct ModelingResult {
-        float FunctionValue;
-        float Radiodensity;
-        StructureId BasicCtStructureId;
-    };
+    using ModelingResult = CtStructureTreeProgram::Result;
+
+    /**
+     * Snapshot of the compiled tree. A modification compiles a new program instead of changing the snapshot,
+     * so it can be read concurrently with edits as long as it is held.
+     */
+    [[nodiscard]] auto
+    GetProgram() const -> std::shared_ptr<CtStructureTreeProgram const>;
 
     [[nodiscard]] auto
-    FunctionValueAndRadiodensity(Point point, CtStructureVariant const* = nullptr) const -> ModelingResult;
+    FunctionValueAndRadiodensity(Point point,
+                                 CtStructureVariant const* = nullptr,
+                                 EvaluationPrecision precision = EvaluationPrecision::DOUBLE) const -> ModelingResult;
 
     [[nodiscard]] auto
-    FunctionValue(Point point, CtStructureVariant const& structure) const -> float;
+    FunctionValue(Point point,
+                  CtStructureVariant const& structure,
+                  EvaluationPrecision precision = EvaluationPrecision::DOUBLE) const -> float;
 
     [[nodiscard]] auto
     ClosestPointOnXYPlane(Point const& point, CtStructureVariant const& structure) const -> std::optional<DoublePoint>;
@@ -113,13 +129,35 @@ public:
     [[nodiscard]] auto
     GetMaxTissueValue(CtStructureVariant const& structure) const -> float;
 
+    /**
+     * Returns the world-space region outside of which the modeling result has not changed since the given tree MTime
+     * or std::nullopt if the changes since then are not known.
+     */
+    [[nodiscard]] auto
+    GetModifiedRegionSince(vtkMTimeType mTime) const -> std::optional<BoundingBox>;
+
 private:
+    [[nodiscard]] auto
+    GetStructureBounds(uidx_t structureIdx) const -> BoundingBox;
+
+    /**
+     * Marks the union of the given bounds from before the modification and the bounds of the given structure after
+     * it as modified. Outside of these bounds the function values of the structure are 0 before and after, so the
+     * (pointwise) combination with the rest of the tree does not change there.
+     * Consumed by the next EmitEvent. Events without recorded modification invalidate all previous ones.
+     */
+    auto
+    RecordModification(BoundingBox const& oldBounds, std::optional<uidx_t> newStructureIdx) -> void;
+
     [[nodiscard]] auto
     CtStructureExists(auto const& ctStructure) const -> bool;
 
     [[nodiscard]] auto
     StructureIdxExists(uidx_t idx) const noexcept -> bool;
 
+    [[nodiscard]] auto
+    IndexOfStoredStructure(CtStructureVariant const& structure) const -> uidx_t;
+
     auto
     EmitEvent(CtStructureTreeEvent event) noexcept -> void;
 
@@ -137,44 +175,34 @@ private:
 
     [[nodiscard]] auto
     TransformPointUntilStructure(Point const& point, CtStructureVariant const& structure) const -> Point {
-        std::vector<CtStructureVariant const*> ancestors;
-
-        idx_t ancestorIdx = std::visit([](auto const& s) { return s.ParentIdx; }, structure);
-        while (ancestorIdx) {
-            auto const& ancestor = GetStructureAt(*ancestorIdx);
-            ancestors.push_back(&ancestor);
-
-            ancestorIdx = std::visit([](auto const& s) { return s.ParentIdx; }, ancestor);
-        }
-
-        return std::accumulate(ancestors.crbegin(), ancestors.crend(), point,
-                        [](Point ancestorPoint, CtStructureVariant const* ancestor) {
-            return std::visit([&](auto const& s) { return s.GetTransformedPoint(ancestorPoint); }, *ancestor);
-        });
+        return GetProgram()->TransformToParentFrame(point, IndexOfStoredStructure(structure));
     }
 
     [[nodiscard]] auto
     TransformPointFromStructure(Point const& point, CtStructureVariant const& structure) const -> Point {
-        std::vector<CtStructureVariant const*> ancestors;
-
-        idx_t ancestorIdx = std::visit([](auto const& s) { return s.ParentIdx; }, structure);
-        while (ancestorIdx) {
-            auto const& ancestor = GetStructureAt(*ancestorIdx);
-            ancestors.push_back(&ancestor);
-
-            ancestorIdx = std::visit([](auto const& s) { return s.ParentIdx; }, ancestor);
-        }
-
-        return std::accumulate(ancestors.cbegin(), ancestors.cend(), point,
-                               [](Point point, CtStructureVariant const* ancestor) {
-            return std::visit([&](auto const& s) { return s.GetInverselyTransformedPoint(point); }, *ancestor);
-        });
+        return GetProgram()->TransformFromParentFrame(point, IndexOfStoredStructure(structure));
     }
 
     vtkTimeStamp MTime;
     std::vector<CtStructureVariant> Structures;
     std::vector<TreeEventCallback> TreeEventCallbacks;
     idx_t RootIdx;
+
+    mutable std::mutex ProgramMutex;
+    mutable std::atomic<vtkMTimeType> ProgramMTime = 0;
+    mutable std::atomic<std::shared_ptr<CtStructureTreeProgram const>> Program {
+            std::make_shared<CtStructureTreeProgram const>() };
+
+    struct ModifiedRegion {
+        vtkMTimeType MTime;
+        BoundingBox Bounds;
+    };
+    static constexpr size_t MaxNumberOfModifiedRegions = 64;
+
+    std::optional<BoundingBox> PendingModifiedRegion;
+    std::deque<ModifiedRegion> ModifiedRegions;
+    vtkMTimeType ModifiedRegionsStartMTime = 0;
+    vtkMTimeType ModifiedRegionsMTime = 0;
 };
 
 
@@ -0,0 +1,647 @@
+#include "CtStructureTreeProgram.h"
+
+#include "CtStructureTree.h"
+#include "ShapeKernels.h"
+#include "../Utils/Overload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+
+[[nodiscard]] static auto
+ConcatenateTransforms(RowMajor4x3Matrix const& outer, RowMajor4x3Matrix const& inner) noexcept -> RowMajor4x3Matrix {
+    RowMajor4x3Matrix result {};
+
+    for (uint8_t row = 0; row < 3; row++) {
+        for (uint8_t col = 0; col < 4; col++) {
+            result(row, col) = outer(row, 0) * inner(0, col)
+                             + outer(row, 1) * inner(1, col)
+                             + outer(row, 2) * inner(2, col);
+        }
+        result(row, 3) += outer(row, 3);
+    }
+
+    return result;
+}
+
+[[nodiscard]] static auto
+TransformPoint(RowMajor4x3Matrix const& matrix, Point const& point) noexcept -> Point {
+    return { matrix(0, 0) * point[0] + matrix(0, 1) * point[1] + matrix(0, 2) * point[2] + matrix(0, 3),
+             matrix(1, 0) * point[0] + matrix(1, 1) * point[1] + matrix(1, 2) * point[2] + matrix(1, 3),
+             matrix(2, 0) * point[0] + matrix(2, 1) * point[1] + matrix(2, 2) * point[2] + matrix(2, 3) };
+}
+
+/**
+ * Bounds of the transformed corners of the box, padded to cover the deviation of the single precision kernels
+ */
+[[nodiscard]] static auto
+TransformBounds(RowMajor4x3Matrix const& matrix, BoundingBox const& box) noexcept -> BoundingBox {
+    if (box.IsEmpty())
+        return box;
+
+    BoundingBox result {};
+    for (uint8_t corner = 0; corner < 8; corner++)
+        result.Extend(TransformPoint(matrix, { (corner & 1) != 0 ? box.Max[0] : box.Min[0],
+                                               (corner & 2) != 0 ? box.Max[1] : box.Min[1],
+                                               (corner & 4) != 0 ? box.Max[2] : box.Min[2] }));
+
+    double const magnitude = std::max({ std::abs(result.Min[0]), std::abs(result.Min[1]), std::abs(result.Min[2]),
+                                        std::abs(result.Max[0]), std::abs(result.Max[1]), std::abs(result.Max[2]) });
+    return result.Padded(1e-3 + 1e-5 * magnitude);
+}
+
+CtStructureTreeProgram::CtStructureTreeProgram(std::vector<CtStructureVariant> const& structures, idx_t rootIdx) :
+        StructureRanges(structures.size()),
+        StructureBounds(structures.size()),
+        AncestorTransforms(structures.size()) {
+
+    if (!rootIdx)
+        return;
+
+    Instructions.reserve(structures.size() * 2);
+
+    StackSize = Compile(structures, *rootIdx, RowMajor4x3Matrix {}, RowMajor4x3Matrix {}, true).StackSize;
+    if (StackSize > MaxStackSize)
+        throw std::runtime_error("structure tree is too deep to be evaluated");
+
+    RootRange = StructureRanges.at(*rootIdx);
+
+    std::vector<BoundingBox> shapeBounds;
+    shapeBounds.reserve(Shapes.size());
+    std::ranges::transform(Shapes, std::back_inserter(shapeBounds),
+                           [this](Shape const& shape) { return StructureBounds[shape.StructureIdx]; });
+    ShapeHierarchy = BoundingVolumeHierarchy { shapeBounds };
+}
+
+auto CtStructureTreeProgram::Compile(std::vector<CtStructureVariant> const& structures,
+                                     uidx_t structureIdx,
+                                     RowMajor4x3Matrix const& parentTransform,
+                                     RowMajor4x3Matrix const& parentInverseTransform,
+                                     bool hasOnlyUnionAncestors) -> CompilationResult {
+    auto const begin = static_cast<uint32_t>(Instructions.size());
+
+    CompilationResult const result = std::visit(Overload {
+        [&](BasicStructure const& basicStructure) -> CompilationResult {
+            Instruction const instruction = CreateShapeInstruction(basicStructure, parentTransform);
+
+            Shapes.emplace_back(Shape { static_cast<uint32_t>(Instructions.size()),
+                                        structureIdx,
+                                        hasOnlyUnionAncestors,
+                                        GetLocalShapeInnerBounds(instruction) });
+            Instructions.emplace_back(instruction);
+
+            RowMajor4x3Matrix const inverseTransform = ConcatenateTransforms(parentInverseTransform,
+                                                                             basicStructure.Transform.GetInverseMatrix());
+
+            return { 1, TransformBounds(inverseTransform, GetLocalShapeBounds(instruction)) };
+        },
+        [&](CombinedStructure const& combinedStructure) -> CompilationResult {
+            auto const& childIndices = combinedStructure.ChildStructureIndices;
+            if (childIndices.empty())
+                throw std::runtime_error("combined structure must have children");
+
+            RowMajor4x3Matrix const transform = ConcatenateTransforms(combinedStructure.Transform.GetMatrix(),
+                                                                      parentTransform);
+            RowMajor4x3Matrix const inverseTransform = ConcatenateTransforms(parentInverseTransform,
+                                                                             combinedStructure.Transform.GetInverseMatrix());
+
+            OpCode const combineCode = [&] {
+                switch (combinedStructure.Operator) {
+                    case CombinedStructure::OperatorType::UNION:        return OpCode::UNION;
+                    case CombinedStructure::OperatorType::INTERSECTION: return OpCode::INTERSECTION;
+                    case CombinedStructure::OperatorType::DIFFERENCE_:  return OpCode::DIFFERENCE_;
+                    default: throw std::runtime_error("invalid operator type");
+                }
+            }();
+
+            bool const childrenHaveOnlyUnionAncestors = hasOnlyUnionAncestors && combineCode == OpCode::UNION;
+
+            // outside of all children every child function value is 0, so the combination is 0 as well
+            CompilationResult combinedResult = Compile(structures, childIndices[0], transform, inverseTransform,
+                                                       childrenHaveOnlyUnionAncestors);
+            for (auto childIt = std::next(childIndices.cbegin()); childIt != childIndices.cend(); ++childIt) {
+                auto const [ childStackSize, childBounds ] = Compile(structures, *childIt, transform, inverseTransform,
+                                                                     childrenHaveOnlyUnionAncestors);
+                combinedResult.StackSize = std::max<uint8_t>(combinedResult.StackSize, 1 + childStackSize);
+                combinedResult.Bounds.Extend(childBounds);
+
+                Instructions.emplace_back(Instruction { combineCode });
+            }
+
+            if (combineCode == OpCode::DIFFERENCE_)
+                Instructions.emplace_back(Instruction { OpCode::CLEAR_EMPTY_DIFFERENCE_ID });
+
+            return combinedResult;
+        }
+    }, structures[structureIdx]);
+
+    StructureRanges[structureIdx] = { begin, static_cast<uint32_t>(Instructions.size()) };
+    StructureBounds[structureIdx] = result.Bounds;
+    AncestorTransforms[structureIdx] = { parentTransform, parentInverseTransform };
+
+    return result;
+}
+
+auto CtStructureTreeProgram::CreateShapeInstruction(BasicStructure const& basicStructure,
+                                                    RowMajor4x3Matrix const& parentTransform) -> Instruction {
+    Instruction instruction {
+            std::visit([](auto const& shape) {
+                using ShapeType = std::decay_t<decltype(shape)>;
+                if constexpr (std::is_same_v<ShapeType, Sphere>)   return OpCode::SPHERE;
+                if constexpr (std::is_same_v<ShapeType, Box>)      return OpCode::BOX;
+                if constexpr (std::is_same_v<ShapeType, Cone>)     return OpCode::CONE;
+                if constexpr (std::is_same_v<ShapeType, Cylinder>) return OpCode::CYLINDER;
+            }, basicStructure.Shape),
+            basicStructure.Id,
+            basicStructure.Tissue.Radiodensity,
+            basicStructure.EvaluationBias,
+            ConcatenateTransforms(basicStructure.Transform.GetMatrix(), parentTransform) };
+
+    auto& parameters = instruction.Parameters;
+    std::visit(Overload {
+        [&](Sphere const& sphere) {
+            sphere.Function->GetCenter(parameters.data());
+            parameters[3] = sphere.Function->GetRadius();
+        },
+        [&](Box const& box) {
+            box.Function->GetXMin(parameters.data());
+            box.Function->GetXMax(std::next(parameters.data(), 3));
+        },
+        [&](Cone const& cone) {
+            parameters[0] = cone.UnboundedCone->GetAngleTangent();
+            parameters[1] = cone.TipPlane->GetOrigin()[2];
+            parameters[2] = cone.BasePlane->GetOrigin()[2];
+        },
+        [&](Cylinder const& cylinder) {
+            parameters[0] = cylinder.UnboundedCylinder->GetRadius();
+            parameters[1] = cylinder.BottomPlane->GetOrigin()[2];
+            parameters[2] = cylinder.TopPlane->GetOrigin()[2];
+        }
+    }, basicStructure.Shape);
+
+    return instruction;
+}
+
+auto CtStructureTreeProgram::ComputeStructureBounds(std::vector<CtStructureVariant> const& structures,
+                                                    uidx_t structureIdx) -> BoundingBox {
+    auto getParentIdx = [&structures](uidx_t idx) {
+        return std::visit([](auto const& structure) { return structure.ParentIdx; }, structures.at(idx));
+    };
+
+    std::vector<uidx_t> ancestorIndices;
+    for (idx_t parentIdx = getParentIdx(structureIdx); parentIdx; parentIdx = getParentIdx(*parentIdx))
+        ancestorIndices.push_back(*parentIdx);
+
+    // the ancestor transforms are folded from the root down, in the same order as during compilation
+    RowMajor4x3Matrix parentInverseTransform {};
+    for (auto it = ancestorIndices.crbegin(); it != ancestorIndices.crend(); ++it) {
+        parentInverseTransform = ConcatenateTransforms(parentInverseTransform, std::visit([](auto const& structure) {
+            return structure.Transform.GetInverseMatrix();
+        }, structures[*it]));
+    }
+
+    return ComputeSubtreeBounds(structures, structureIdx, parentInverseTransform);
+}
+
+auto CtStructureTreeProgram::ComputeSubtreeBounds(std::vector<CtStructureVariant> const& structures,
+                                                  uidx_t structureIdx,
+                                                  RowMajor4x3Matrix const& parentInverseTransform) -> BoundingBox {
+    return std::visit(Overload {
+        [&](BasicStructure const& basicStructure) {
+            RowMajor4x3Matrix const inverseTransform = ConcatenateTransforms(parentInverseTransform,
+                                                                             basicStructure.Transform.GetInverseMatrix());
+            return TransformBounds(inverseTransform,
+                                   GetLocalShapeBounds(CreateShapeInstruction(basicStructure, RowMajor4x3Matrix {})));
+        },
+        [&](CombinedStructure const& combinedStructure) {
+            RowMajor4x3Matrix const inverseTransform = ConcatenateTransforms(parentInverseTransform,
+                                                                             combinedStructure.Transform.GetInverseMatrix());
+            BoundingBox bounds {};
+            for (uidx_t const childIdx : combinedStructure.ChildStructureIndices)
+                bounds.Extend(ComputeSubtreeBounds(structures, childIdx, inverseTransform));
+            return bounds;
+        }
+    }, structures.at(structureIdx));
+}
+
+auto CtStructureTreeProgram::TransformToParentFrame(Point const& point, uidx_t structureIdx) const noexcept -> Point {
+    return TransformPoint(AncestorTransforms[structureIdx].WorldToParent, point);
+}
+
+auto CtStructureTreeProgram::TransformFromParentFrame(Point const& point, uidx_t structureIdx) const noexcept -> Point {
+    return TransformPoint(AncestorTransforms[structureIdx].ParentToWorld, point);
+}
+
+auto CtStructureTreeProgram::GetLocalShapeBounds(Instruction const& instruction) noexcept -> BoundingBox {
+    auto const& p = instruction.Parameters;
+
+    switch (instruction.Code) {
+        case OpCode::SPHERE:
+            return { { p[0] - p[3], p[1] - p[3], p[2] - p[3] },
+                     { p[0] + p[3], p[1] + p[3], p[2] + p[3] } };
+
+        case OpCode::BOX:
+            return { { p[0], p[1], p[2] },
+                     { p[3], p[4], p[5] } };
+
+        case OpCode::CONE: {
+            double const radius = std::abs(p[0]) * std::max(std::abs(p[1]), std::abs(p[2]));
+            return { { -radius, -radius, p[1] },
+                     {  radius,  radius, p[2] } };
+        }
+
+        case OpCode::CYLINDER:
+            return { { -p[0], -p[0], p[1] },
+                     {  p[0],  p[0], p[2] } };
+
+        default: return {};
+    }
+}
+
+/**
+ * Box within the shape, shrunk so that the single precision kernels are negative within it as well.
+ * It is empty if the bias may lift negative function values to 0.
+ */
+auto CtStructureTreeProgram::GetLocalShapeInnerBounds(Instruction const& instruction) noexcept -> BoundingBox {
+    if (instruction.EvaluationBias > 0.0F)
+        return {};
+
+    auto const& p = instruction.Parameters;
+    double const halfSqrt2 = std::sqrt(0.5);
+
+    BoundingBox const innerBounds = [&]() -> BoundingBox {
+        switch (instruction.Code) {
+            case OpCode::SPHERE: {
+                double const halfLength = p[3] / std::sqrt(3.0);
+                return { { p[0] - halfLength, p[1] - halfLength, p[2] - halfLength },
+                         { p[0] + halfLength, p[1] + halfLength, p[2] + halfLength } };
+            }
+
+            case OpCode::BOX:
+                return { { p[0], p[1], p[2] },
+                         { p[3], p[4], p[5] } };
+
+            case OpCode::CONE: {
+                // the radius grows with the distance to the tip at the origin, so it is smallest at the nearer plane
+                if (p[1] <= 0.0 && p[2] >= 0.0)
+                    return {};
+
+                double const halfLength = std::abs(p[0]) * std::min(std::abs(p[1]), std::abs(p[2])) * halfSqrt2;
+                return { { -halfLength, -halfLength, p[1] },
+                         {  halfLength,  halfLength, p[2] } };
+            }
+
+            case OpCode::CYLINDER: {
+                double const halfLength = p[0] * halfSqrt2;
+                return { { -halfLength, -halfLength, p[1] },
+                         {  halfLength,  halfLength, p[2] } };
+            }
+
+            default: return {};
+        }
+    }();
+
+    if (innerBounds.IsEmpty())
+        return innerBounds;
+
+    double const magnitude = std::max({ std::abs(innerBounds.Min[0]), std::abs(innerBounds.Min[1]),
+                                        std::abs(innerBounds.Min[2]), std::abs(innerBounds.Max[0]),
+                                        std::abs(innerBounds.Max[1]), std::abs(innerBounds.Max[2]) });
+    return innerBounds.Padded(-(1e-3 + 1e-5 * magnitude));
+}
+
+auto CtStructureTreeProgram::IsWithinShape(BoundingBox const& region, Shape const& shape) const noexcept -> bool {
+    BoundingBox const& innerBounds = shape.LocalInnerBounds;
+    if (innerBounds.IsEmpty())
+        return false;
+
+    // the inner bounds are convex, so the region is within them if all of its transformed corners are
+    RowMajor4x3Matrix const& transform = Instructions[shape.InstructionIdx].Transform;
+    for (uint8_t corner = 0; corner < 8; corner++) {
+        Point const localCorner = TransformPoint(transform, { (corner & 1) != 0 ? region.Max[0] : region.Min[0],
+                                                              (corner & 2) != 0 ? region.Max[1] : region.Min[1],
+                                                              (corner & 4) != 0 ? region.Max[2] : region.Min[2] });
+        for (uint8_t i = 0; i < 3; i++) {
+            if (localCorner[i] < innerBounds.Min[i] || localCorner[i] > innerBounds.Max[i])
+                return false;
+        }
+    }
+
+    return true;
+}
+
+auto CtStructureTreeProgram::SelectRegion(BoundingBox const& region, RowBuffer& buffer) const -> RegionType {
+    buffer.Shapes.clear();
+    ShapeHierarchy.Query(region, buffer.Shapes);
+
+    if (buffer.Shapes.empty()) {
+        buffer.Range = InstructionRange {};
+        return RegionType::EMPTY;
+    }
+
+    if (Shape const& shape = Shapes[buffer.Shapes.front()]; buffer.Shapes.size() == 1 && shape.HasOnlyUnionAncestors) {
+        buffer.Range = InstructionRange { shape.InstructionIdx, shape.InstructionIdx + 1 };
+        buffer.ShapeIsActive.clear();
+        return IsWithinShape(region, shape) ? RegionType::INTERIOR : RegionType::SINGLE_STRUCTURE;
+    }
+
+    buffer.Range = RootRange;
+    buffer.ShapeIsActive.assign(Instructions.size(), 0);
+    for (uint32_t const shapeIdx : buffer.Shapes)
+        buffer.ShapeIsActive[Shapes[shapeIdx].InstructionIdx] = 1;
+
+    return RegionType::MIXED;
+}
+
+template<typename T>
+auto CtStructureTreeProgram::EvaluateShape(Instruction const& instruction, Vector<T> const& point) noexcept -> T {
+    auto const p = [&instruction](size_t i) { return static_cast<T>(instruction.Parameters[i]); };
+
+    switch (instruction.Code) {
+        case OpCode::SPHERE:  // vtkSphere
+            return (point[0] - p(0)) * (point[0] - p(0))
+                   + (point[1] - p(1)) * (point[1] - p(1))
+                   + (point[2] - p(2)) * (point[2] - p(2))
+                   - p(3) * p(3);
+
+        case OpCode::BOX: {  // vtkBox
+            T minDistance = std::numeric_limits<T>::lowest();
+            T distance = 0.0;
+            bool inside = true;
+            for (uint8_t i = 0; i < 3; i++) {
+                T const min = p(i);
+                T const max = p(i + 3);
+                T const length = max - min;
+                T dist = 0.0;
+
+                if (length != 0.0) {
+                    T const t = (point[i] - min) / length;
+                    if (t < 0.0) {
+                        inside = false;
+                        dist = min - point[i];
+                    } else if (t > 1.0) {
+                        inside = false;
+                        dist = point[i] - max;
+                    } else {
+                        dist = t <= 0.5
+                                ? min - point[i]
+                                : point[i] - max;
+
+                        minDistance = std::max(minDistance, dist);
+                    }
+                } else {
+                    dist = std::abs(point[i] - min);
+                    if (dist > 0.0)
+                        inside = false;
+                }
+
+                if (dist > 0.0)
+                    distance += dist * dist;
+            }
+
+            return inside
+                    ? minDistance
+                    : std::sqrt(distance);
+        }
+
+        case OpCode::CONE: {  // intersection of ImplicitCone, tip plane and base plane
+            T const tanTheta = p(0);
+            T const cone = point[0] * point[0] + point[1] * point[1] - point[2] * point[2] * tanTheta * tanTheta;
+            return std::max({ cone, -(point[2] - p(1)), point[2] - p(2) });
+        }
+
+        case OpCode::CYLINDER: {  // intersection of vtkCylinder, bottom plane and top plane
+            T const cylinder = point[0] * point[0] + point[1] * point[1] + point[2] * point[2]
+                               - point[2] * point[2] - p(0) * p(0);
+            return std::max({ cylinder, -(point[2] - p(1)), point[2] - p(2) });
+        }
+
+        default: return 0.0;
+    }
+}
+
+template<typename T>
+auto CtStructureTreeProgram::EvaluateShapeRow(Instruction const& instruction,
+                                              Point const& start,
+                                              DoubleVector const& step,
+                                              std::span<T> values) noexcept -> void {
+    auto const& matrix = instruction.Transform;
+    Point const transformedStart = TransformPoint(matrix, start);
+    Vector<T> const localStart { static_cast<T>(transformedStart[0]),
+                                 static_cast<T>(transformedStart[1]),
+                                 static_cast<T>(transformedStart[2]) };
+    Vector<T> const localStep {
+            static_cast<T>(matrix(0, 0) * step[0] + matrix(0, 1) * step[1] + matrix(0, 2) * step[2]),
+            static_cast<T>(matrix(1, 0) * step[0] + matrix(1, 1) * step[1] + matrix(1, 2) * step[2]),
+            static_cast<T>(matrix(2, 0) * step[0] + matrix(2, 1) * step[1] + matrix(2, 2) * step[2]) };
+
+    auto const p = [&instruction](size_t i) { return static_cast<T>(instruction.Parameters[i]); };
+
+    switch (instruction.Code) {
+        case OpCode::SPHERE:
+            ShapeKernels::EvaluateRow(ShapeKernels::SphereKernel<T> { { p(0), p(1), p(2) }, p(3) },
+                                      localStart, localStep, values);
+            break;
+
+        case OpCode::BOX:
+            ShapeKernels::EvaluateRow(ShapeKernels::BoxKernel<T> { { p(0), p(1), p(2) }, { p(3), p(4), p(5) } },
+                                      localStart, localStep, values);
+            break;
+
+        case OpCode::CONE:
+            ShapeKernels::EvaluateRow(ShapeKernels::ConeKernel<T> { p(0), p(1), p(2) },
+                                      localStart, localStep, values);
+            break;
+
+        case OpCode::CYLINDER:
+            ShapeKernels::EvaluateRow(ShapeKernels::CylinderKernel<T> { p(0), p(1), p(2) },
+                                      localStart, localStep, values);
+            break;
+
+        default: break;
+    }
+}
+
+auto CtStructureTreeProgram::EvaluateRow(Point const& start,
+                                         DoubleVector const& step,
+                                         uint32_t numberOfPoints,
+                                         RowBuffer& buffer,
+                                         EvaluationPrecision precision) const -> void {
+    size_t const bufferSize = static_cast<size_t>(std::max<uint8_t>(StackSize, 1)) * numberOfPoints;
+    if (buffer.FunctionValues.size() < bufferSize) {
+        buffer.FunctionValues.resize(bufferSize);
+        buffer.Radiodensities.resize(bufferSize);
+        buffer.BasicCtStructureIds.resize(bufferSize);
+    }
+
+    InstructionRange const range = buffer.Range.value_or(RootRange);
+    if (range.Begin == range.End) {
+        std::fill_n(buffer.FunctionValues.begin(), numberOfPoints, 0.0F);
+        std::fill_n(buffer.Radiodensities.begin(), numberOfPoints, 0.0F);
+        std::fill_n(buffer.BasicCtStructureIds.begin(), numberOfPoints, 0);
+        return;
+    }
+
+    auto level = [&buffer, numberOfPoints](uint8_t stackIdx) {
+        size_t const offset = static_cast<size_t>(stackIdx) * numberOfPoints;
+        return std::tuple { std::span { std::next(buffer.FunctionValues.data(), offset), numberOfPoints },
+                            std::span { std::next(buffer.Radiodensities.data(), offset), numberOfPoints },
+                            std::span { std::next(buffer.BasicCtStructureIds.data(), offset), numberOfPoints } };
+    };
+
+    bool const allShapesAreActive = !buffer.Range || buffer.ShapeIsActive.empty();
+    uint8_t stackSize = 0;
+
+    for (uint32_t instructionIdx = range.Begin; instructionIdx < range.End; instructionIdx++) {
+        Instruction const& instruction = Instructions[instructionIdx];
+
+        switch (instruction.Code) {
+            case OpCode::SPHERE:
+            case OpCode::BOX:
+            case OpCode::CONE:
+            case OpCode::CYLINDER: {
+                auto [ functionValues, radiodensities, ids ] = level(stackSize++);
+
+                if (allShapesAreActive || buffer.ShapeIsActive[instructionIdx] != 0) {
+                    if (precision == EvaluationPrecision::DOUBLE) {
+                        buffer.ShapeValues.resize(numberOfPoints);
+                        EvaluateShapeRow(instruction, start, step, std::span { buffer.ShapeValues });
+                        std::ranges::transform(buffer.ShapeValues, functionValues.begin(),
+                                               [](double value) { return static_cast<float>(value); });
+                    } else
+                        EvaluateShapeRow(instruction, start, step, functionValues);
+
+                    float const bias = instruction.EvaluationBias;
+                    for (float& value : functionValues)
+                        value = std::min(value < 0.0F ? value + bias : value, 0.0F);
+                } else
+                    std::ranges::fill(functionValues, 0.0F);
+
+                std::ranges::fill(radiodensities, instruction.Radiodensity);
+                std::ranges::fill(ids, instruction.Id);
+                break;
+            }
+
+            case OpCode::UNION:
+            case OpCode::INTERSECTION: {
+                auto [ otherValues, otherRadiodensities, otherIds ] = level(--stackSize);
+                auto [ functionValues, radiodensities, ids ] = level(stackSize - 1);
+
+                bool const isUnion = instruction.Code == OpCode::UNION;
+                for (uint32_t i = 0; i < numberOfPoints; i++) {
+                    bool const takeOther = isUnion
+                            ? otherValues[i] < functionValues[i]
+                            : otherValues[i] > functionValues[i];
+
+                    functionValues[i] = takeOther ? otherValues[i]         : functionValues[i];
+                    radiodensities[i] = takeOther ? otherRadiodensities[i] : radiodensities[i];
+                    ids[i]            = takeOther ? otherIds[i]            : ids[i];
+                }
+                break;
+            }
+
+            case OpCode::DIFFERENCE_: {
+                auto [ otherValues, otherRadiodensities, otherIds ] = level(--stackSize);
+                auto [ functionValues, radiodensities, ids ] = level(stackSize - 1);
+
+                for (uint32_t i = 0; i < numberOfPoints; i++) {
+                    radiodensities[i] -= otherValues[i] < 0.0F ? otherRadiodensities[i] : 0.0F;
+                    functionValues[i] -= otherValues[i];
+                }
+                break;
+            }
+
+            case OpCode::CLEAR_EMPTY_DIFFERENCE_ID: {
+                auto [ functionValues, radiodensities, ids ] = level(stackSize - 1);
+
+                for (uint32_t i = 0; i < numberOfPoints; i++)
+                    ids[i] = radiodensities[i] == 0.0F ? static_cast<StructureId>(-1) : ids[i];
+                break;
+            }
+        }
+    }
+}
+
+template<typename T>
+auto CtStructureTreeProgram::Run(Point const& point, InstructionRange range) const noexcept -> Result {
+    if (range.Begin == range.End)
+        return {};
+
+    std::array<Result, MaxStackSize> stack;
+    uint8_t stackSize = 0;
+
+    for (auto it = std::next(Instructions.cbegin(), range.Begin),
+              end = std::next(Instructions.cbegin(), range.End);
+         it != end; ++it) {
+        Instruction const& instruction = *it;
+
+        switch (instruction.Code) {
+            case OpCode::SPHERE:
+            case OpCode::BOX:
+            case OpCode::CONE:
+            case OpCode::CYLINDER: {
+                Point const localPoint = TransformPoint(instruction.Transform, point);
+                auto const value = static_cast<float>(EvaluateShape<T>(instruction,
+                                                                       { static_cast<T>(localPoint[0]),
+                                                                         static_cast<T>(localPoint[1]),
+                                                                         static_cast<T>(localPoint[2]) }));
+                stack[stackSize++] = { std::min(value < 0.0F ? value + instruction.EvaluationBias
+                                                             : value,
+                                                0.0F),
+                                       instruction.Radiodensity,
+                                       instruction.Id };
+                break;
+            }
+
+            case OpCode::UNION: {
+                Result const& other = stack[--stackSize];
+                Result& result = stack[stackSize - 1];
+                if (other.FunctionValue < result.FunctionValue)
+                    result = other;
+                break;
+            }
+
+            case OpCode::INTERSECTION: {
+                Result const& other = stack[--stackSize];
+                Result& result = stack[stackSize - 1];
+                if (other.FunctionValue > result.FunctionValue)
+                    result = other;
+                break;
+            }
+
+            case OpCode::DIFFERENCE_: {
+                Result const& other = stack[--stackSize];
+                Result& result = stack[stackSize - 1];
+                result.FunctionValue -= other.FunctionValue;
+                if (other.FunctionValue < 0.0F)
+                    result.Radiodensity -= other.Radiodensity;
+                break;
+            }
+
+            case OpCode::CLEAR_EMPTY_DIFFERENCE_ID: {
+                Result& result = stack[stackSize - 1];
+                if (result.Radiodensity == 0.0F)
+                    result.BasicCtStructureId = -1;
+                break;
+            }
+        }
+    }
+
+    return stack[0];
+}
+
+auto CtStructureTreeProgram::Evaluate(Point const& point, EvaluationPrecision precision) const noexcept -> Result {
+    return precision == EvaluationPrecision::DOUBLE
+            ? Run<double>(point, RootRange)
+            : Run<float>(point, RootRange);
+}
+
+auto CtStructureTreeProgram::Evaluate(Point const& point,
+                                      uidx_t structureIdx,
+                                      EvaluationPrecision precision) const noexcept -> Result {
+    return precision == EvaluationPrecision::DOUBLE
+            ? Run<double>(point, StructureRanges[structureIdx])
+            : Run<float>(point, StructureRanges[structureIdx]);
+}
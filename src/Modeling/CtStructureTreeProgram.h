@@ -0,0 +1,212 @@
+#pragma once
+
+#include "../Utils/BoundingBox.h"
+#include "../Utils/BoundingVolumeHierarchy.h"
+#include "../Utils/IndexTypes.h"
+#include "../Utils/SimpleTransform.h"
+
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+class BasicStructure;
+class CtStructureVariant;
+
+
+/** Floating point type the shape functions are evaluated in */
+enum struct EvaluationPrecision : uint8_t {
+    SINGLE,
+    DOUBLE
+};
+
+
+/**
+ * Flat post-order representation of a CtStructureTree.
+ * Every basic structure becomes a shape instruction carrying its world-to-local transform (all ancestor transforms
+ * folded in), every combined structure becomes a sequence of binary combine instructions working on a fixed-size
+ * value stack. The subtree of each structure occupies a contiguous instruction range, so any structure can be
+ * evaluated on its own.
+ * Conservative world-space bounds of the region where a structure's function value may be non-zero are computed for
+ * every structure, and the basic structure bounds are organised in a bounding volume hierarchy so that regions of
+ * the volume can be restricted to the shapes that actually reach into them.
+ */
+class CtStructureTreeProgram {
+public:
+    struct Result {
+        float FunctionValue;
+        float Radiodensity;
+        StructureId BasicCtStructureId;
+    };
+
+    CtStructureTreeProgram() = default;
+    CtStructureTreeProgram(std::vector<CtStructureVariant> const& structures, idx_t rootIdx);
+
+    [[nodiscard]] auto
+    Evaluate(Point const& point, EvaluationPrecision precision = EvaluationPrecision::DOUBLE) const noexcept -> Result;
+
+    [[nodiscard]] auto
+    Evaluate(Point const& point,
+             uidx_t structureIdx,
+             EvaluationPrecision precision = EvaluationPrecision::DOUBLE) const noexcept -> Result;
+
+    struct InstructionRange {
+        uint32_t Begin = 0;
+        uint32_t End = 0;
+    };
+
+    enum struct RegionType : uint8_t {
+        EMPTY,            // no structure reaches into the region
+        SINGLE_STRUCTURE, // a single basic structure that is only combined by unions reaches into the region
+        INTERIOR,         // like SINGLE_STRUCTURE, but the region lies entirely inside the structure's shape
+        MIXED
+    };
+
+    struct RowBuffer {
+        std::vector<float> FunctionValues;
+        std::vector<float> Radiodensities;
+        std::vector<StructureId> BasicCtStructureIds;
+        std::vector<double> ShapeValues;
+
+        std::optional<InstructionRange> Range;
+        std::vector<uint8_t> ShapeIsActive;
+        std::vector<uint32_t> Shapes;
+    };
+
+    /**
+     * Restricts subsequent row evaluations with the buffer to the shapes whose bounds intersect the region.
+     * Shapes outside the region are not evaluated, their (exactly zero) function values are filled in instead.
+     * Within an INTERIOR region every point has the single structure's radiodensity and basic structure id
+     * (asserted against the pointwise evaluation in debug builds of ImplicitCtDataSource).
+     */
+    auto
+    SelectRegion(BoundingBox const& region, RowBuffer& buffer) const -> RegionType;
+
+    /**
+     * Evaluates the points start + i * step (i < numberOfPoints) using the batched shape kernels of the given precision.
+     * The results are stored in the first numberOfPoints elements of the buffer's arrays.
+     */
+    auto
+    EvaluateRow(Point const& start,
+                DoubleVector const& step,
+                uint32_t numberOfPoints,
+                RowBuffer& buffer,
+                EvaluationPrecision precision) const -> void;
+
+    [[nodiscard]] auto
+    GetNumberOfInstructions() const noexcept -> size_t { return Instructions.size(); }
+
+    [[nodiscard]] auto
+    GetBounds() const noexcept -> BoundingBox { return ShapeHierarchy.GetBounds(); }
+
+    [[nodiscard]] auto
+    GetStructureBounds(uidx_t structureIdx) const -> BoundingBox { return StructureBounds.at(structureIdx); }
+
+    /**
+     * The bounds GetStructureBounds returns after compiling the structures, computed from the structure's subtree
+     * and ancestors only
+     */
+    [[nodiscard]] static auto
+    ComputeStructureBounds(std::vector<CtStructureVariant> const& structures, uidx_t structureIdx) -> BoundingBox;
+
+    /** Transforms a world point into the coordinate frame of the structure's parent (all ancestor transforms applied) */
+    [[nodiscard]] auto
+    TransformToParentFrame(Point const& point, uidx_t structureIdx) const noexcept -> Point;
+
+    /** Inverse of TransformToParentFrame */
+    [[nodiscard]] auto
+    TransformFromParentFrame(Point const& point, uidx_t structureIdx) const noexcept -> Point;
+
+    static constexpr uint8_t MaxStackSize = 64;
+
+private:
+    enum struct OpCode : uint8_t {
+        SPHERE,
+        BOX,
+        CONE,
+        CYLINDER,
+        UNION,
+        INTERSECTION,
+        DIFFERENCE_,
+        CLEAR_EMPTY_DIFFERENCE_ID
+    };
+
+    struct Instruction {
+        OpCode Code;
+        StructureId Id = 0;
+        float Radiodensity = 0.0F;
+        float EvaluationBias = 0.0F;
+        RowMajor4x3Matrix Transform {};
+        std::array<double, 6> Parameters {};
+    };
+
+    struct Shape {
+        uint32_t InstructionIdx;
+        uidx_t StructureIdx;
+        bool HasOnlyUnionAncestors;
+        BoundingBox LocalInnerBounds; // in the shape's local frame, the function value is negative within them
+    };
+
+    struct AncestorTransform {
+        RowMajor4x3Matrix WorldToParent;
+        RowMajor4x3Matrix ParentToWorld;
+    };
+
+    struct CompilationResult {
+        uint8_t StackSize;
+        BoundingBox Bounds;
+    };
+
+    auto
+    Compile(std::vector<CtStructureVariant> const& structures,
+            uidx_t structureIdx,
+            RowMajor4x3Matrix const& parentTransform,
+            RowMajor4x3Matrix const& parentInverseTransform,
+            bool hasOnlyUnionAncestors) -> CompilationResult;
+
+    [[nodiscard]] static auto
+    CreateShapeInstruction(BasicStructure const& basicStructure,
+                           RowMajor4x3Matrix const& parentTransform) -> Instruction;
+
+    [[nodiscard]] static auto
+    ComputeSubtreeBounds(std::vector<CtStructureVariant> const& structures,
+                         uidx_t structureIdx,
+                         RowMajor4x3Matrix const& parentInverseTransform) -> BoundingBox;
+
+    [[nodiscard]] static auto
+    GetLocalShapeBounds(Instruction const& instruction) noexcept -> BoundingBox;
+
+    [[nodiscard]] static auto
+    GetLocalShapeInnerBounds(Instruction const& instruction) noexcept -> BoundingBox;
+
+    [[nodiscard]] auto
+    IsWithinShape(BoundingBox const& region, Shape const& shape) const noexcept -> bool;
+
+    template<typename T>
+    using Vector = std::array<T, 3>;
+
+    template<typename T>
+    [[nodiscard]] static auto
+    EvaluateShape(Instruction const& instruction, Vector<T> const& point) noexcept -> T;
+
+    template<typename T>
+    static auto
+    EvaluateShapeRow(Instruction const& instruction,
+                     Point const& start,
+                     DoubleVector const& step,
+                     std::span<T> values) noexcept -> void;
+
+    template<typename T>
+    [[nodiscard]] auto
+    Run(Point const& point, InstructionRange range) const noexcept -> Result;
+
+    std::vector<Instruction> Instructions;
+    std::vector<InstructionRange> StructureRanges;
+    std::vector<BoundingBox> StructureBounds;
+    std::vector<AncestorTransform> AncestorTransforms;
+    InstructionRange RootRange {};
+    uint8_t StackSize = 0;
+
+    std::vector<Shape> Shapes;
+    BoundingVolumeHierarchy ShapeHierarchy;
+};
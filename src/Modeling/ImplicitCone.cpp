@@ -22,13 +22,15 @@ auto ImplicitCone::SetAngle(double angleDeg) -> void {
 
 auto ImplicitCone::GetAngle() const noexcept -> double { return vtkMath::DegreesFromRadians(Angle); }
 
+auto ImplicitCone::GetAngleTangent() const noexcept -> double { return tan(vtkMath::RadiansFromDegrees(Angle)); }
+
 auto ImplicitCone::EvaluateFunction(double x[3]) -> double {
-    double const tanTheta = tan(vtkMath::RadiansFromDegrees(Angle));
+    double const tanTheta = GetAngleTangent();
     return x[0] * x[0] + x[1] * x[1] - x[2] * x[2] * tanTheta * tanTheta;
 }
 
 void ImplicitCone::EvaluateGradient(double x[3], double g[3]) {
-    double const tanTheta = tan(vtkMath::RadiansFromDegrees(Angle));
+    double const tanTheta = GetAngleTangent();
     g[0] = -2.0 * x[0] * tanTheta * tanTheta;
     g[1] = 2.0 * x[1];
     g[2] = 2.0 * x[2];
@@ -23,6 +23,9 @@ public:
     [[nodiscard]] auto
     GetAngle() const noexcept -> double;
 
+    [[nodiscard]] auto
+    GetAngleTangent() const noexcept -> double;
+
 protected:
     ImplicitCone();
     ~ImplicitCone() override = default;
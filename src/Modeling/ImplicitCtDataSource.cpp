@@ -10,7 +10,12 @@
 #include <vtkPointData.h>
 #include <vtkSMPTools.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
-#include <vtkTypeUInt16Array.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
 
 vtkStandardNewMacro(ImplicitCtDataSource)
 
@@ -18,62 +23,393 @@ void ImplicitCtDataSource::PrintSelf(ostream &os, vtkIndent indent) {
     Superclass::PrintSelf(os, indent);
 
     os << indent << "Implicit CT Structures: (" << DataTree << ")\n";
+    os << indent << "Progressive: " << Progressive << " (Preview Resolution: " << PreviewResolution << ")\n";
+    os << indent << "Evaluation Precision: " << (Precision == EvaluationPrecision::SINGLE ? "Single" : "Double") << "\n";
 }
 
 auto ImplicitCtDataSource::GetMTime() -> vtkMTimeType {
     vtkMTimeType const mTime = Superclass::GetMTime();
     vtkMTimeType const treeMTime = DataTree ? DataTree->GetMTime() : 0;
 
-    return std::max({ mTime, treeMTime });
+    return std::max({ mTime, treeMTime, RefinementTime.GetMTime() });
+}
+
+ImplicitCtDataSource::~ImplicitCtDataSource() {
+    std::thread refinementThread = std::move(RefinementThread);
+    CancelRefinement();
+
+    // does not outlive the source, only an aborted level is waited for
+    if (refinementThread.joinable())
+        refinementThread.join();
 }
 
 void ImplicitCtDataSource::SetDataTree(CtStructureTree* ctStructureTree) { DataTree = ctStructureTree; }
 
+auto ImplicitCtDataSource::CopyParameters(ImplicitCtDataSource const& other) -> void {
+    SetDataTree(other.DataTree);
+    SetVolumeDataPhysicalDimensions(other.PhysicalDimensions);
+    SetVolumeNumberOfVoxels(other.NumberOfVoxels);
+    SetEvaluationPrecision(other.Precision);
+}
+
+auto ImplicitCtDataSource::SetEvaluationPrecision(EvaluationPrecision precision) -> void {
+    if (precision == Precision)
+        return;
+
+    Precision = precision;
+    Modified();
+}
+
+auto ImplicitCtDataSource::ValidatePrecision() const -> PrecisionReport {
+    if (!DataTree || !DataTree->HasRoot())
+        return {};
+
+    std::shared_ptr<CtStructureTreeProgram const> const program = DataTree->GetProgram();
+    std::array<int, 3> const dimensions = GetDimensions();
+    std::array<double, 3> const origin = GetOrigin();
+    std::array<double, 3> const spacing = GetSpacing();
+    DoubleVector const step { spacing[0], 0.0, 0.0 };
+    auto const rowLength = static_cast<uint32_t>(dimensions[0]);
+    ImageDataUtils::Grid const grid { dimensions, spacing, origin };
+
+    std::vector<PrecisionReport> rowReports(grid.GetNumberOfRows());
+    ImageDataUtils::ForEachTile(grid, [&](ImageDataUtils::Tile const& tile) {
+        CtStructureTreeProgram::RowBuffer singleBuffer;
+        CtStructureTreeProgram::RowBuffer doubleBuffer;
+
+        tile.ForEachRow([&](ImageDataUtils::Row const& row) {
+            program->EvaluateRow(row.StartPoint, step, rowLength, singleBuffer, EvaluationPrecision::SINGLE);
+            program->EvaluateRow(row.StartPoint, step, rowLength, doubleBuffer, EvaluationPrecision::DOUBLE);
+
+            PrecisionReport& report = rowReports[static_cast<vtkIdType>(row.Z) * dimensions[1] + row.Y];
+            report.NumberOfPoints = rowLength;
+            for (uint32_t x = 0; x < rowLength; x++) {
+                bool const singleIsInside = singleBuffer.FunctionValues[x] < 0.0F;
+                bool const doubleIsInside = doubleBuffer.FunctionValues[x] < 0.0F;
+                float const singleRadiodensity = singleIsInside ? singleBuffer.Radiodensities[x] : -1000.0F;
+                float const doubleRadiodensity = doubleIsInside ? doubleBuffer.Radiodensities[x] : -1000.0F;
+                StructureId const singleId = singleIsInside ? singleBuffer.BasicCtStructureIds[x] : 0;
+                StructureId const doubleId = doubleIsInside ? doubleBuffer.BasicCtStructureIds[x] : 0;
+
+                report.MaxFunctionValueDeviation = std::max(report.MaxFunctionValueDeviation,
+                                                            std::abs(singleBuffer.FunctionValues[x]
+                                                                     - doubleBuffer.FunctionValues[x]));
+                report.MaxRadiodensityDeviation = std::max(report.MaxRadiodensityDeviation,
+                                                           std::abs(singleRadiodensity - doubleRadiodensity));
+                if (singleId != doubleId)
+                    report.NumberOfClassificationMismatches++;
+            }
+        });
+    });
+
+    PrecisionReport report {};
+    for (PrecisionReport const& rowReport : rowReports) {
+        report.MaxFunctionValueDeviation = std::max(report.MaxFunctionValueDeviation,
+                                                    rowReport.MaxFunctionValueDeviation);
+        report.MaxRadiodensityDeviation = std::max(report.MaxRadiodensityDeviation,
+                                                   rowReport.MaxRadiodensityDeviation);
+        report.NumberOfClassificationMismatches += rowReport.NumberOfClassificationMismatches;
+        report.NumberOfPoints += rowReport.NumberOfPoints;
+    }
+
+    return report;
+}
+
+auto ImplicitCtDataSource::SetProgressive(bool progressive) -> void {
+    if (progressive == Progressive)
+        return;
+
+    CancelRefinement();
+    Progressive = progressive;
+    AppliedLevel.reset();
+    Modified();
+}
+
+auto ImplicitCtDataSource::SetPreviewResolution(int resolution) -> void {
+    if (resolution < 1)
+        throw std::runtime_error("preview resolution must be positive");
+
+    if (resolution == PreviewResolution)
+        return;
+
+    PreviewResolution = resolution;
+    Modified();
+}
+
+auto ImplicitCtDataSource::SetRefinementCallback(RefinementCallback&& callback) -> void {
+    CancelRefinement();
+    OnRefinement = std::move(callback);
+}
+
+auto ImplicitCtDataSource::ApplyRefinement() -> bool {
+    std::optional<RefinementLevel> level;
+    if (Refinement) {
+        std::scoped_lock const lock { Refinement->Mutex };
+        level.swap(Refinement->PendingLevel);
+    }
+
+    if (!level || !IsCurrent(*level))
+        return false;
+
+    AppliedLevel = std::move(level);
+    RefinementTime.Modified();
+    return true;
+}
+
+auto ImplicitCtDataSource::ResetRefinement() -> void {
+    CancelRefinement();
+    AppliedLevel.reset();
+    RefinementTime.Modified();
+}
+
+auto ImplicitCtDataSource::IsCurrent(RefinementLevel const& level) -> bool {
+    return level.SourceMTime == Superclass::GetMTime()
+            && DataTree && level.TreeMTime == DataTree->GetMTime();
+}
+
+auto ImplicitCtDataSource::GetCoarseDivisor() const noexcept -> int {
+    int const maxNumberOfVoxels = std::ranges::max(NumberOfVoxels);
+
+    int divisor = 1;
+    while (maxNumberOfVoxels / divisor > PreviewResolution)
+        divisor *= 2;
+
+    return divisor;
+}
+
+[[nodiscard]] static auto
+GetDownsampledNumberOfVoxels(std::array<int, 3> numberOfVoxels, int divisor) noexcept -> std::array<int, 3> {
+    for (int& voxels : numberOfVoxels)
+        voxels = std::max((voxels + divisor - 1) / divisor, 1);
+
+    return numberOfVoxels;
+}
+
+auto ImplicitCtDataSource::GetSampledNumberOfVoxels() const -> std::array<int, 3> {
+    if (!Progressive)
+        return NumberOfVoxels;
+
+    return GetDownsampledNumberOfVoxels(NumberOfVoxels, AppliedLevel ? AppliedLevel->Divisor : GetCoarseDivisor());
+}
+
+auto ImplicitCtDataSource::RequestInformation(vtkInformation* request,
+                                              vtkInformationVector** inputVector,
+                                              vtkInformationVector* outputVector) -> int {
+    if (AppliedLevel && !IsCurrent(*AppliedLevel))
+        AppliedLevel.reset();
+
+    return Superclass::RequestInformation(request, inputVector, outputVector);
+}
+
+template<typename TArray>
+[[nodiscard]] static auto
+GetWritableArray(vtkSmartPointer<TArray> const& previousArray, char const* name, vtkIdType numberOfPoints,
+                 bool keepValues) -> vtkSmartPointer<TArray> {
+    // arrays that are still shared with downstream consumers must not be modified in place
+    if (keepValues && previousArray && previousArray->GetNumberOfTuples() == numberOfPoints) {
+        if (previousArray->GetReferenceCount() == 1)
+            return previousArray;
+
+        vtkNew<TArray> array;
+        array->DeepCopy(previousArray);
+        return array;
+    }
+
+    vtkNew<TArray> array;
+    array->SetNumberOfComponents(1);
+    array->SetName(name);
+    array->SetNumberOfTuples(numberOfPoints);
+    return array;
+}
+
+template<typename T>
+[[nodiscard]] static auto
+GetWritableArray(vtkSmartPointer<BrickSparseDataArray<T>> const& previousArray, char const* name,
+                 std::array<int, 3> dimensions, bool keepValues) -> vtkSmartPointer<BrickSparseDataArray<T>> {
+    if (keepValues && previousArray && previousArray->GetDimensions() == dimensions) {
+        if (previousArray->GetReferenceCount() == 1)
+            return previousArray;
+
+        vtkNew<BrickSparseDataArray<T>> array;
+        array->DeepCopy(previousArray);
+        return array;
+    }
+
+    vtkNew<BrickSparseDataArray<T>> array;
+    array->SetName(name);
+    array->SetDimensions(dimensions);
+    return array;
+}
+
 void ImplicitCtDataSource::ExecuteDataWithInformation(vtkDataObject *output, vtkInformation *outInfo) {
     vtkImageData* data = vtkImageData::SafeDownCast(output);
     int* updateExtent = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
     data->SetExtent(updateExtent);
     vtkIdType const numberOfPoints = data->GetNumberOfPoints();
 
-    vtkFloatArray* radiodensityArray = vtkFloatArray::New();
-    radiodensityArray->SetNumberOfComponents(1);
-    radiodensityArray->SetName("Radiodensities");
-    radiodensityArray->SetNumberOfTuples(numberOfPoints);
-    data->GetPointData()->SetScalars(radiodensityArray);
-    radiodensityArray->Delete();
-    float* radiodensities = radiodensityArray->WritePointer(0, numberOfPoints);
-
-    vtkFloatArray* functionValueArray = vtkFloatArray::New();
-    functionValueArray->SetNumberOfComponents(1);
-    functionValueArray->SetName("FunctionValues");
-    functionValueArray->SetNumberOfTuples(numberOfPoints);
-    data->GetPointData()->AddArray(functionValueArray);
-    functionValueArray->Delete();
-    float* functionValues = functionValueArray->WritePointer(0, numberOfPoints);
-
-    vtkTypeUInt16Array* basicStructureIdArray = vtkTypeUInt16Array::New();
-    basicStructureIdArray->SetNumberOfComponents(1);
-    basicStructureIdArray->SetName("BasicStructureIds");
-    basicStructureIdArray->SetNumberOfTuples(numberOfPoints);
-    data->GetPointData()->AddArray(basicStructureIdArray);
-    basicStructureIdArray->Delete();
-    uint16_t* basicStructureIds = basicStructureIdArray->WritePointer(0, numberOfPoints);
+    std::array<int, 6> extent {};
+    std::copy(updateExtent, std::next(updateExtent, 6), extent.begin());
+
+    if (AppliedLevel && AppliedLevel->Radiodensities->GetNumberOfTuples() == numberOfPoints) {
+        data->GetPointData()->SetScalars(AppliedLevel->Radiodensities);
+        data->GetPointData()->AddArray(AppliedLevel->FunctionValues);
+        data->GetPointData()->AddArray(AppliedLevel->BasicStructureIds);
+        return;
+    }
+
+    CancelRefinement();
+
+    std::optional<BoundingBox> const modifiedRegion
+            = DataTree->HasRoot() && Previous.TreeMTime != 0
+                      && Previous.Extent == extent && Previous.SourceMTime == Superclass::GetMTime()
+                      ? DataTree->GetModifiedRegionSince(Previous.TreeMTime)
+                      : std::nullopt;
+
+    std::array<int, 3> const dimensions { extent[1] - extent[0] + 1,
+                                          extent[3] - extent[2] + 1,
+                                          extent[5] - extent[4] + 1 };
+
+    Previous.Radiodensities = GetWritableArray(Previous.Radiodensities, "Radiodensities",
+                                               numberOfPoints, modifiedRegion.has_value());
+    Previous.FunctionValues = GetWritableArray(Previous.FunctionValues, "FunctionValues",
+                                               dimensions, modifiedRegion.has_value());
+    Previous.BasicStructureIds = GetWritableArray(Previous.BasicStructureIds, "BasicStructureIds",
+                                                  dimensions, modifiedRegion.has_value());
+    Previous.TreeMTime = 0;
+
+    data->GetPointData()->SetScalars(Previous.Radiodensities);
+    data->GetPointData()->AddArray(Previous.FunctionValues);
+    data->GetPointData()->AddArray(Previous.BasicStructureIds);
+    float* radiodensities = Previous.Radiodensities->WritePointer(0, numberOfPoints);
 
     if (!DataTree->HasRoot()) {
         vtkDebugMacro("Ct data tree has 0 nodes. Cannot evaluate");
         return;
     }
 
-    SampleAlgorithm sampleAlgorithm { this, data, DataTree, radiodensities, functionValues, basicStructureIds };
-    vtkSMPTools::For(0, numberOfPoints, sampleAlgorithm);
+    std::shared_ptr<CtStructureTreeProgram const> const program = DataTree->GetProgram();
+    std::array<int, 3> regionBegin {};
+    std::array<int, 3> regionEnd = dimensions;
+    if (modifiedRegion) {
+        if (modifiedRegion->IsEmpty())
+            regionEnd = regionBegin;
+
+        Point startPoint {};
+        data->GetPoint(0, startPoint.data());
+        std::array<double, 3> const spacing = GetSpacing();
+        for (uint8_t i = 0; i < 3 && !modifiedRegion->IsEmpty(); i++) {
+            regionBegin[i] = std::clamp(static_cast<int>(std::floor((modifiedRegion->Min[i] - startPoint[i]) / spacing[i])),
+                                        0, dimensions[i]);
+            regionEnd[i] = std::clamp(static_cast<int>(std::ceil((modifiedRegion->Max[i] - startPoint[i]) / spacing[i])) + 1,
+                                      regionBegin[i], dimensions[i]);
+        }
+
+        // whole storage bricks are re-evaluated
+        for (uint8_t i = 0; i < 3 && regionBegin[i] < regionEnd[i]; i++) {
+            regionBegin[i] -= regionBegin[i] % BrickSize;
+            regionEnd[i] = std::min((regionEnd[i] + BrickSize - 1) / BrickSize * BrickSize, dimensions[i]);
+        }
+    }
+
+    SampleAlgorithm sampleAlgorithm { this, data, program.get(), Precision, radiodensities,
+                                      Previous.FunctionValues, Previous.BasicStructureIds, regionBegin, regionEnd };
+    vtkSMPTools::For(0, sampleAlgorithm.GetTotalNumberOfBricks(), sampleAlgorithm);
+
+    if (GetAbortOutput())
+        return;
+
+    Previous.Extent = extent;
+    Previous.SourceMTime = Superclass::GetMTime();
+    Previous.TreeMTime = DataTree->GetMTime();
+
+    if (Progressive)
+        StartRefinement();
+}
+
+auto ImplicitCtDataSource::StartRefinement() -> void {
+    int const coarseDivisor = GetCoarseDivisor();
+    if (coarseDivisor == 1)
+        return;
+
+    Refinement = std::make_shared<RefinementTask>();
+    Refinement->Sampler = vtkSmartPointer<ImplicitCtDataSource>::New();
+    Refinement->Sampler->SetVolumeDataPhysicalDimensions(PhysicalDimensions);
+    Refinement->OnRefinement = OnRefinement;
+
+    RefinementThread = std::thread([task = Refinement,
+                                    program = DataTree->GetProgram(),
+                                    numberOfVoxels = NumberOfVoxels,
+                                    precision = Precision,
+                                    sourceMTime = Superclass::GetMTime(),
+                                    treeMTime = DataTree->GetMTime(),
+                                    coarseDivisor] {
+        ImplicitCtDataSource& sampler = *task->Sampler;
+
+        for (int divisor = coarseDivisor / 2; divisor >= 1 && !task->Cancelled; divisor /= 2) {
+            sampler.SetVolumeNumberOfVoxels(GetDownsampledNumberOfVoxels(numberOfVoxels, divisor));
+
+            vtkNew<vtkImageData> volume;
+            volume->SetExtent(sampler.GetWholeExtent().data());
+            volume->SetOrigin(sampler.GetOrigin().data());
+            volume->SetSpacing(sampler.GetSpacing().data());
+            vtkIdType const numberOfPoints = volume->GetNumberOfPoints();
+            std::array<int, 3> const dimensions { volume->GetDimensions()[0],
+                                                  volume->GetDimensions()[1],
+                                                  volume->GetDimensions()[2] };
+
+            RefinementLevel level { divisor,
+                                    GetWritableArray(vtkSmartPointer<vtkFloatArray> {}, "Radiodensities",
+                                                     numberOfPoints, false),
+                                    GetWritableArray(vtkSmartPointer<BrickSparseDataArray<float>> {}, "FunctionValues",
+                                                     dimensions, false),
+                                    GetWritableArray(vtkSmartPointer<BrickSparseDataArray<StructureId>> {},
+                                                     "BasicStructureIds", dimensions, false),
+                                    sourceMTime,
+                                    treeMTime };
+
+            SampleAlgorithm sampleAlgorithm { &sampler, volume, program.get(), precision,
+                                              level.Radiodensities->WritePointer(0, numberOfPoints),
+                                              level.FunctionValues, level.BasicStructureIds,
+                                              {}, dimensions };
+            vtkSMPTools::For(0, sampleAlgorithm.GetTotalNumberOfBricks(), sampleAlgorithm);
+
+            // the callback runs under the lock, so it is never called after CancelRefinement has returned
+            std::scoped_lock const lock { task->Mutex };
+            if (task->Cancelled || sampler.GetAbortOutput())
+                return;
+
+            task->PendingLevel = std::move(level);
+            if (task->OnRefinement)
+                task->OnRefinement();
+        }
+    });
+}
+
+auto ImplicitCtDataSource::CancelRefinement() -> void {
+    if (!Refinement)
+        return;
+
+    {
+        std::scoped_lock const lock { Refinement->Mutex };
+        Refinement->Cancelled = true;
+        Refinement->PendingLevel.reset();
+    }
+    Refinement->Sampler->SetAbortExecuteAndUpdateTime();
+    Refinement.reset();
+
+    if (RefinementThread.joinable())
+        RefinementThread.detach();
 }
 
 ImplicitCtDataSource::SampleAlgorithm::SampleAlgorithm(ImplicitCtDataSource* self,
                                                        vtkImageData* volumeData,
-                                                       CtStructureTree* tree,
+                                                       CtStructureTreeProgram const* program,
+                                                       EvaluationPrecision precision,
                                                        float* radiodensities,
-                                                       float* functionValues,
-                                                       uint16_t* basicStructureIds) :
+                                                       BrickSparseDataArray<float>* functionValues,
+                                                       BrickSparseDataArray<StructureId>* basicStructureIds,
+                                                       std::array<int, 3> regionBegin,
+                                                       std::array<int, 3> regionEnd) :
         Self(self),
         VolumeData(volumeData),
         Spacing(self->GetSpacing()),
@@ -87,68 +423,109 @@ ImplicitCtDataSource::SampleAlgorithm::SampleAlgorithm(ImplicitCtDataSource* sel
             VolumeData->GetPoint(0, startPoint.data());
             return startPoint;
         }()),
-        Tree(tree),
+        Program(program),
+        Precision(precision),
         Radiodensities(radiodensities),
         FunctionValues(functionValues),
-        BasicStructureIds(basicStructureIds) {}
+        BasicStructureIds(basicStructureIds),
+        RegionBegin(regionBegin),
+        RegionEnd(regionEnd),
+        NumberOfBricks { (RegionEnd[0] - RegionBegin[0] + BrickSize - 1) / BrickSize,
+                         (RegionEnd[1] - RegionBegin[1] + BrickSize - 1) / BrickSize,
+                         (RegionEnd[2] - RegionBegin[2] + BrickSize - 1) / BrickSize } {}
 
-void ImplicitCtDataSource::SampleAlgorithm::operator()(vtkIdType pointId, vtkIdType endPointId) const {
+void ImplicitCtDataSource::SampleAlgorithm::operator()(vtkIdType brickId, vtkIdType endBrickId) const {
     Self->CheckAbort();
 
     if (Self->GetAbortOutput())
         return;
 
-    std::array<int, 3> const startPointCoordinates = PointIdToDimensionCoordinates(pointId, UpdateDims);
-    std::array<int, 3> const endPointCoordinates = PointIdToDimensionCoordinates(endPointId, UpdateDims);
-    auto [ x1, y1, z1 ] = startPointCoordinates;
-    auto lastValidPointCoordinates = GetDecrementedCoordinates(endPointCoordinates, UpdateDims);
-    auto [ x2, y2, z2 ] = lastValidPointCoordinates;
-
-    Point point = StartPoint;
-    point[0] += x1 * Spacing[0];
-    point[1] += y1 * Spacing[1];
-    point[2] += z1 * Spacing[2];
-
-    for (vtkIdType z = z1; z <= z2; z++) {
-        vtkIdType y = 0;
-        if (z == z1)
-            y = y1;
-
-        vtkIdType yEnd = UpdateDims[1] - 1;
-        if (z == z2)
-            yEnd = y2;
-
-        for (; y <= yEnd; y++) {
-            vtkIdType x = 0;
-            if (z == z1 && y == y1)
-                x = x1;
-
-            vtkIdType xEnd = UpdateDims[0] - 1;
-            if (z == z2 && y == y2)
-                xEnd = x2;
-
-            for (; x <= xEnd; x++) {
-                auto const [functionValue, radiodensity, basicCtStructureId] = Tree->FunctionValueAndRadiodensity(point);
-
-                bool const pointIsWithinStructure = functionValue < 0;
-                FunctionValues[pointId] = functionValue;
-                Radiodensities[pointId] = pointIsWithinStructure
-                                          ? radiodensity
-                                          : -1000.0f;
-                BasicStructureIds[pointId] = pointIsWithinStructure
-                                             ? basicCtStructureId
-                                             : 0;
-                pointId++;
-
-                point[0] += Spacing[0];
-            }
+    DoubleVector const step { Spacing[0], 0.0, 0.0 };
+    CtStructureTreeProgram::RowBuffer buffer;
+    std::array<float, BrickSparseDataArray<float>::BrickVolume> brickFunctionValues {};
+    std::array<StructureId, BrickSparseDataArray<StructureId>::BrickVolume> brickStructureIds {};
 
-            point[0] = StartPoint[0];
-            point[1] += Spacing[1];
+    for (; brickId < endBrickId; brickId++) {
+        std::array<int, 3> const brick = PointIdToDimensionCoordinates(brickId, NumberOfBricks);
+        std::array<int, 3> begin {};
+        std::array<int, 3> end {};
+        BoundingBox region {};
+        for (uint8_t i = 0; i < 3; i++) {
+            begin[i] = RegionBegin[i] + brick[i] * BrickSize;
+            end[i] = std::min(begin[i] + BrickSize, RegionEnd[i]);
+            region.Min[i] = StartPoint[i] + begin[i] * Spacing[i];
+            region.Max[i] = StartPoint[i] + (end[i] - 1) * Spacing[i];
         }
 
-        point[0] = StartPoint[0];
-        point[1] = StartPoint[1];
-        point[2] += Spacing[2];
+        auto const rowLength = static_cast<uint32_t>(end[0] - begin[0]);
+        vtkIdType const storageBrickIdx = FunctionValues->GetBrickIdx(begin[0], begin[1], begin[2]);
+        CtStructureTreeProgram::RegionType const regionType = Program->SelectRegion(region, buffer);
+        bool const isEmpty = regionType == CtStructureTreeProgram::RegionType::EMPTY;
+        bool const isInterior = regionType == CtStructureTreeProgram::RegionType::INTERIOR;
+
+        if (isEmpty) {
+            FunctionValues->FillBrick(storageBrickIdx, 0.0F);
+            BasicStructureIds->FillBrick(storageBrickIdx, 0);
+        }
+
+        for (int z = begin[2]; z < end[2]; z++) {
+            for (int y = begin[1]; y < end[1]; y++) {
+                vtkIdType const pointId = (static_cast<vtkIdType>(z) * UpdateDims[1] + y) * UpdateDims[0] + begin[0];
+
+                if (isEmpty) {
+                    std::fill_n(std::next(Radiodensities, pointId), rowLength, -1000.0F);
+                    continue;
+                }
+
+                Point const rowStart { region.Min[0],
+                                       StartPoint[1] + y * Spacing[1],
+                                       StartPoint[2] + z * Spacing[2] };
+
+                Program->EvaluateRow(rowStart, step, rowLength, buffer, Precision);
+
+                int const brickRowOffset = ((z - begin[2]) * BrickSize + y - begin[1]) * BrickSize;
+                if (isInterior) {
+                    // every point is within the structure, only the function values vary
+                    assert(([this, &rowStart, &step, &buffer, rowLength]() -> bool {
+                        // the region classification agrees with the pointwise classification by the whole tree
+                        for (uint32_t x = 0; x < rowLength; x++) {
+                            CtStructureTreeProgram::Result const result = Program->Evaluate(
+                                    { rowStart[0] + x * step[0], rowStart[1], rowStart[2] }, Precision);
+                            if (!(result.FunctionValue < 0.0F)
+                                    || result.Radiodensity != buffer.Radiodensities[0]
+                                    || result.BasicCtStructureId != buffer.BasicCtStructureIds[0])
+                                return false;
+                        }
+                        return true;
+                    })());
+
+                    std::copy_n(buffer.FunctionValues.cbegin(), rowLength,
+                                std::next(brickFunctionValues.begin(), brickRowOffset));
+                    std::fill_n(std::next(Radiodensities, pointId), rowLength, buffer.Radiodensities[0]);
+                    continue;
+                }
+
+                for (uint32_t x = 0; x < rowLength; x++) {
+                    float const functionValue = buffer.FunctionValues[x];
+
+                    bool const pointIsWithinStructure = functionValue < 0;
+                    brickFunctionValues[brickRowOffset + x] = functionValue;
+                    Radiodensities[pointId + x] = pointIsWithinStructure
+                                                  ? buffer.Radiodensities[x]
+                                                  : -1000.0f;
+                    brickStructureIds[brickRowOffset + x] = pointIsWithinStructure
+                                                            ? buffer.BasicCtStructureIds[x]
+                                                            : 0;
+                }
+            }
+        }
+
+        if (isInterior) {
+            FunctionValues->SetBrickValues(storageBrickIdx, brickFunctionValues);
+            BasicStructureIds->FillBrick(storageBrickIdx, buffer.BasicCtStructureIds[0]);
+        } else if (!isEmpty) {
+            FunctionValues->SetBrickValues(storageBrickIdx, brickFunctionValues);
+            BasicStructureIds->SetBrickValues(storageBrickIdx, brickStructureIds);
+        }
     }
 }
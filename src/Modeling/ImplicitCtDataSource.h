@@ -1,8 +1,19 @@
 #pragma once
 
 #include "CtDataSource.h"
+#include "CtStructureTreeProgram.h"
+#include "../Utils/BrickSparseDataArray.h"
+
+#include <vtkFloatArray.h>
+#include <vtkSmartPointer.h>
 
 #include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 class CtStructureTree;
 
@@ -17,35 +28,176 @@ public:
 
     void SetDataTree(CtStructureTree* ctStructureTree);
 
+    /** Copies the tree, the volume dimensions and the evaluation precision of another source */
+    auto
+    CopyParameters(ImplicitCtDataSource const& other) -> void;
+
+    [[nodiscard]] auto
+    GetEvaluationPrecision() const noexcept -> EvaluationPrecision { return Precision; }
+
+    /** Sets the precision the shape functions are evaluated in. Results are always stored in single precision. */
+    auto
+    SetEvaluationPrecision(EvaluationPrecision precision) -> void;
+
+    struct PrecisionReport {
+        float MaxFunctionValueDeviation = 0.0F;
+        float MaxRadiodensityDeviation = 0.0F;
+        vtkIdType NumberOfClassificationMismatches = 0; // points assigned to a different basic structure
+        vtkIdType NumberOfPoints = 0;
+    };
+
+    /**
+     * Evaluates the whole volume in single and in double precision and reports the maximum deviation of the single
+     * precision results from the double precision ones. Image generation logs the report for single precision sources.
+     */
+    [[nodiscard]] auto
+    ValidatePrecision() const -> PrecisionReport;
+
+    /**
+     * In progressive mode the volume is first sampled with at most PreviewResolution voxels along each axis.
+     * Finer levels, each doubling the resolution up to the set number of voxels, are then sampled on a background
+     * thread. Any change of the source or the tree cancels the refinement and restarts at the coarse level.
+     */
+    auto
+    SetProgressive(bool progressive) -> void;
+
+    [[nodiscard]] auto
+    GetProgressive() const noexcept -> bool { return Progressive; }
+
+    auto
+    SetPreviewResolution(int resolution) -> void;
+
+    using RefinementCallback = std::function<void()>;
+
+    /**
+     * Called from the background thread whenever a finer level is ready to be applied.
+     * Must not call back into the source synchronously, e.g. post ApplyRefinement to the UI thread instead.
+     */
+    auto
+    SetRefinementCallback(RefinementCallback&& callback) -> void;
+
+    /**
+     * Makes the next update output the finest level sampled in the background so far.
+     * Must be called from the thread the pipeline is updated from. Returns whether the output changes.
+     */
+    auto
+    ApplyRefinement() -> bool;
+
+    /** Makes the next update start at the coarse level again */
+    auto
+    ResetRefinement() -> void;
+
     ImplicitCtDataSource(const ImplicitCtDataSource&) = delete;
     void operator=(const ImplicitCtDataSource&) = delete;
 
 protected:
     ImplicitCtDataSource() = default;
-    ~ImplicitCtDataSource() override = default;
+    ~ImplicitCtDataSource() override;
+
+    int RequestInformation(vtkInformation* request,
+                           vtkInformationVector** inputVector,
+                           vtkInformationVector* outputVector) override;
 
     void ExecuteDataWithInformation(vtkDataObject *output, vtkInformation *outInfo) override;
 
+    std::array<int, 3> GetSampledNumberOfVoxels() const override;
+
     struct SampleAlgorithm {
         ImplicitCtDataSource* Self;
         vtkImageData* VolumeData;
         std::array<double, 3> Spacing;
         std::array<int, 3> UpdateDims;
         DoublePoint StartPoint;
-        CtStructureTree* Tree;
+        CtStructureTreeProgram const* Program;
+        EvaluationPrecision Precision;
         float* Radiodensities;
-        float* FunctionValues;
-        uint16_t* BasicStructureIds;
+        BrickSparseDataArray<float>* FunctionValues;
+        BrickSparseDataArray<StructureId>* BasicStructureIds;
 
         SampleAlgorithm(ImplicitCtDataSource* self,
                         vtkImageData* volumeData,
-                        CtStructureTree* tree,
+                        CtStructureTreeProgram const* program,
+                        EvaluationPrecision precision,
                         float* radiodensities,
-                        float* functionValues,
-                        uint16_t* basicStructureIds);
+                        BrickSparseDataArray<float>* functionValues,
+                        BrickSparseDataArray<StructureId>* basicStructureIds,
+                        std::array<int, 3> regionBegin,
+                        std::array<int, 3> regionEnd);
+
+        std::array<int, 3> RegionBegin;
+        std::array<int, 3> RegionEnd;
+        std::array<int, 3> NumberOfBricks;
 
-        void operator()(vtkIdType pointId, vtkIdType endPointId) const;
+        /**
+         * Evaluates the bricks [brickId, endBrickId). Bricks no structure reaches into are filled with air, all
+         * others are evaluated row by row, restricted to the structures that reach into them.
+         * The region must begin at a multiple of BrickSize, so that each brick coincides with a storage brick.
+         */
+        void operator()(vtkIdType brickId, vtkIdType endBrickId) const;
+
+        [[nodiscard]] auto
+        GetTotalNumberOfBricks() const noexcept -> vtkIdType {
+            return static_cast<vtkIdType>(NumberOfBricks[0]) * NumberOfBricks[1] * NumberOfBricks[2];
+        }
     };
 
+    static constexpr int BrickSize = BrickSparseDataArray<float>::BrickSize;
+
     CtStructureTree* DataTree = nullptr;
+    EvaluationPrecision Precision = EvaluationPrecision::SINGLE;
+
+    /**
+     * Arrays of the last complete execution. If only the tree has changed since then, only the region modified by the
+     * tree edits is re-evaluated.
+     */
+    struct PreviousOutput {
+        vtkSmartPointer<vtkFloatArray> Radiodensities;
+        vtkSmartPointer<BrickSparseDataArray<float>> FunctionValues;
+        vtkSmartPointer<BrickSparseDataArray<StructureId>> BasicStructureIds;
+        std::array<int, 6> Extent {};
+        vtkMTimeType SourceMTime = 0;
+        vtkMTimeType TreeMTime = 0;
+    } Previous;
+
+    struct RefinementLevel {
+        int Divisor = 1;
+        vtkSmartPointer<vtkFloatArray> Radiodensities;
+        vtkSmartPointer<BrickSparseDataArray<float>> FunctionValues;
+        vtkSmartPointer<BrickSparseDataArray<StructureId>> BasicStructureIds;
+        vtkMTimeType SourceMTime = 0;
+        vtkMTimeType TreeMTime = 0;
+    };
+
+    [[nodiscard]] auto
+    IsCurrent(RefinementLevel const& level) -> bool;
+
+    [[nodiscard]] auto
+    GetCoarseDivisor() const noexcept -> int;
+
+    /**
+     * State of one refinement run, shared with its background thread, which may outlive a cancellation.
+     * The thread samples with its own source, so it never touches this one.
+     */
+    struct RefinementTask {
+        std::atomic<bool> Cancelled = false;
+        vtkSmartPointer<ImplicitCtDataSource> Sampler;
+        RefinementCallback OnRefinement;
+        std::optional<RefinementLevel> PendingLevel; // guarded by Mutex
+        std::mutex Mutex;
+    };
+
+    auto
+    StartRefinement() -> void;
+
+    /** Signals the running refinement to stop without waiting for it */
+    auto
+    CancelRefinement() -> void;
+
+    bool Progressive = false;
+    int PreviewResolution = 48;
+    RefinementCallback OnRefinement;
+    vtkTimeStamp RefinementTime;
+    std::optional<RefinementLevel> AppliedLevel;
+    std::shared_ptr<RefinementTask> Refinement;
+    std::thread RefinementThread;
 };
@@ -0,0 +1,123 @@
+#include "ShapeKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+
+template<typename T, template<typename> typename Kernel>
+auto EvaluateRowWith(Simd::InstructionSet instructionSet,
+                     Kernel<T> const& kernel,
+                     ShapeKernels::Vector<T> const& start,
+                     ShapeKernels::Vector<T> const& step,
+                     std::span<T> values) noexcept -> void {
+    switch (instructionSet) {
+#ifdef UP_SIMD_DISPATCH
+        case Simd::InstructionSet::AVX512: ShapeKernels::Avx512::EvaluateRow(kernel, start, step, values); return;
+        case Simd::InstructionSet::AVX2:   ShapeKernels::Avx2::EvaluateRow(kernel, start, step, values); return;
+#endif
+        default: ShapeKernels::EvaluateBatchedRow<Simd::NativeBatch<T>>(kernel, start, step, values);
+    }
+}
+
+/** Kernels of the given precision with a size of about SampleRadius, centered near the origin */
+template<typename T>
+auto GetSampleKernels() noexcept {
+    return std::tuple { ShapeKernels::SphereKernel<T>   { { T(1.5), T(-2.0), T(3.0) }, T(20.0) },
+                        ShapeKernels::BoxKernel<T>      { { T(-20.0), T(-15.0), T(-10.0) }, { T(20.0), T(15.0), T(10.0) } },
+                        ShapeKernels::ConeKernel<T>     { T(1.0), T(0.0), T(20.0) },
+                        ShapeKernels::CylinderKernel<T> { T(20.0), T(-20.0), T(20.0) } };
+}
+
+auto ShapeKernels::GetRelativeDeviation(Simd::InstructionSet instructionSet) noexcept -> double {
+    static constexpr double SampleRadius = 20.0;
+    static constexpr size_t NumberOfPoints = 83; // not a multiple of a batch width, so the scalar remainder is covered
+    static constexpr Vector<double> Step { 0.97, 0.41, -0.53 };
+    static constexpr std::array<Vector<double>, 4> Starts {{ { -40.0, -30.0,  25.0 },
+                                                             { -40.0,   0.5,   0.0 },
+                                                             { -40.0,  12.0, -19.5 },
+                                                             {  -0.3,  -0.2,  22.0 } }};
+
+    std::vector<double> referenceValues(NumberOfPoints);
+    std::vector<float> singleValues(NumberOfPoints);
+    std::vector<double> doubleValues(NumberOfPoints);
+    double maxDeviation = 0.0;
+
+    auto compare = [&](auto const& referenceKernel, auto const& singleKernel, auto const& doubleKernel) {
+        for (auto const& start : Starts) {
+            Vector<float> const singleStart { static_cast<float>(start[0]), static_cast<float>(start[1]), static_cast<float>(start[2]) };
+            Vector<float> const singleStep { static_cast<float>(Step[0]), static_cast<float>(Step[1]), static_cast<float>(Step[2]) };
+
+            EvaluateBatchedRow<Simd::ScalarBatch<double>>(referenceKernel, start, Step, std::span { referenceValues });
+            EvaluateRowWith(instructionSet, singleKernel, singleStart, singleStep, std::span { singleValues });
+            EvaluateRowWith(instructionSet, doubleKernel, start, Step, std::span { doubleValues });
+
+            for (size_t i = 0; i < NumberOfPoints; i++) {
+                auto const idx = static_cast<double>(i);
+                double const x = start[0] + idx * Step[0];
+                double const y = start[1] + idx * Step[1];
+                double const z = start[2] + idx * Step[2];
+                double const squaredNorm = x * x + y * y + z * z;
+                double const tolerance = 1e-6 * (squaredNorm + std::sqrt(squaredNorm) + SampleRadius * SampleRadius);
+
+                double const singleDeviation = std::abs(static_cast<double>(singleValues[i]) - referenceValues[i]);
+                double const doubleDeviation = std::abs(doubleValues[i] - referenceValues[i]);
+                maxDeviation = std::max({ maxDeviation, singleDeviation / tolerance, doubleDeviation / tolerance });
+            }
+        }
+    };
+
+    auto const referenceKernels = GetSampleKernels<double>();
+    auto const singleKernels = GetSampleKernels<float>();
+    compare(std::get<0>(referenceKernels), std::get<0>(singleKernels), std::get<0>(referenceKernels));
+    compare(std::get<1>(referenceKernels), std::get<1>(singleKernels), std::get<1>(referenceKernels));
+    compare(std::get<2>(referenceKernels), std::get<2>(singleKernels), std::get<2>(referenceKernels));
+    compare(std::get<3>(referenceKernels), std::get<3>(singleKernels), std::get<3>(referenceKernels));
+
+    return maxDeviation;
+}
+
+/**
+ * Instruction set of the host, unless its kernels are not compiled in or fail the comparison with the scalar path
+ */
+auto GetKernelInstructionSet() noexcept -> Simd::InstructionSet {
+    static Simd::InstructionSet const instructionSet = [] {
+#ifdef UP_SIMD_DISPATCH
+        Simd::InstructionSet const hostInstructionSet = Simd::GetHostInstructionSet();
+#else
+        Simd::InstructionSet const hostInstructionSet = Simd::InstructionSet::BASELINE;
+#endif
+        char const* name = Simd::GetInstructionSetName(hostInstructionSet);
+
+        if (double const deviation = ShapeKernels::GetRelativeDeviation(hostInstructionSet); deviation > 1.0) {
+            spdlog::error("{} shape kernels deviate from the scalar path by {:.2f} times the tolerance",
+                          name, deviation);
+            return Simd::InstructionSet::BASELINE;
+        }
+
+        spdlog::info("Evaluating shapes with the {} kernels", name);
+        return hostInstructionSet;
+    }();
+
+    return instructionSet;
+}
+
+template<typename T, template<typename> typename Kernel>
+auto ShapeKernels::EvaluateRow(Kernel<T> const& kernel,
+                               Vector<T> const& start,
+                               Vector<T> const& step,
+                               std::span<T> values) noexcept -> void {
+    EvaluateRowWith(GetKernelInstructionSet(), kernel, start, step, values);
+}
+
+template auto ShapeKernels::EvaluateRow(SphereKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::EvaluateRow(BoxKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::EvaluateRow(ConeKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::EvaluateRow(CylinderKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::EvaluateRow(SphereKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
+template auto ShapeKernels::EvaluateRow(BoxKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
+template auto ShapeKernels::EvaluateRow(ConeKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
+template auto ShapeKernels::EvaluateRow(CylinderKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "../Utils/LinearAlgebraTypes.h"
+#include "../Utils/Simd.h"
+
+#include <array>
+#include <span>
+
+
+/**
+ * Row-batched evaluation of the basic structure shapes in single or double precision.
+ * A row consists of the points start + i * step (in the local coordinates of the shape), which is how volumes are
+ * sampled along the x-axis. The kernels reproduce the function values of the corresponding VTK implicit functions
+ * (vtkSphere, vtkBox, vtkImplicitBoolean intersections for cone and cylinder). Computed in float, results
+ * deviate from the double precision VTK results by at most about 1e-6 * (|p|^2 + r^2) for the quadric terms and
+ * 1e-6 * |p| for the planar terms (p: local point, r: radius), so signs may only differ within that band around
+ * the surface.
+ */
+namespace ShapeKernels {
+
+    template<typename T>
+    using Vector = std::array<T, 3>;
+
+    template<typename T>
+    struct SphereKernel {
+        Vector<T> Center;
+        T Radius;
+
+        template<typename Batch>
+        [[nodiscard]] auto
+        operator()(Batch x, Batch y, Batch z) const noexcept -> Batch {
+            Batch const dx = x - Batch::Broadcast(Center[0]);
+            Batch const dy = y - Batch::Broadcast(Center[1]);
+            Batch const dz = z - Batch::Broadcast(Center[2]);
+            return dx * dx + dy * dy + dz * dz - Batch::Broadcast(Radius * Radius);
+        }
+    };
+
+    template<typename T>
+    struct BoxKernel {
+        Vector<T> MinPoint;
+        Vector<T> MaxPoint;
+
+        template<typename Batch>
+        [[nodiscard]] auto
+        operator()(Batch x, Batch y, Batch z) const noexcept -> Batch {
+            // signed distances to the slabs; all non-positive iff the point is inside the box
+            Batch const dx = Max(Batch::Broadcast(MinPoint[0]) - x, x - Batch::Broadcast(MaxPoint[0]));
+            Batch const dy = Max(Batch::Broadcast(MinPoint[1]) - y, y - Batch::Broadcast(MaxPoint[1]));
+            Batch const dz = Max(Batch::Broadcast(MinPoint[2]) - z, z - Batch::Broadcast(MaxPoint[2]));
+
+            Batch const zero = Batch::Broadcast(T {});
+            auto const inside = Simd::And(Simd::And(LessEqual(dx, zero), LessEqual(dy, zero)), LessEqual(dz, zero));
+
+            Batch const ox = Max(dx, zero);
+            Batch const oy = Max(dy, zero);
+            Batch const oz = Max(dz, zero);
+
+            return Select(inside,
+                          Max(Max(dx, dy), dz),
+                          Sqrt(ox * ox + oy * oy + oz * oz));
+        }
+    };
+
+    template<typename T>
+    struct ConeKernel {
+        T AngleTangent;
+        T TipHeight;
+        T BaseHeight;
+
+        template<typename Batch>
+        [[nodiscard]] auto
+        operator()(Batch x, Batch y, Batch z) const noexcept -> Batch {
+            Batch const tanSquared = Batch::Broadcast(AngleTangent * AngleTangent);
+            Batch const cone = x * x + y * y - z * z * tanSquared;
+            Batch const tipPlane = Batch::Broadcast(TipHeight) - z;
+            Batch const basePlane = z - Batch::Broadcast(BaseHeight);
+            return Max(Max(cone, tipPlane), basePlane);
+        }
+    };
+
+    template<typename T>
+    struct CylinderKernel {
+        T Radius;
+        T BottomHeight;
+        T TopHeight;
+
+        template<typename Batch>
+        [[nodiscard]] auto
+        operator()(Batch x, Batch y, Batch z) const noexcept -> Batch {
+            Batch const cylinder = x * x + y * y - Batch::Broadcast(Radius * Radius);
+            Batch const bottomPlane = Batch::Broadcast(BottomHeight) - z;
+            Batch const topPlane = z - Batch::Broadcast(TopHeight);
+            return Max(Max(cylinder, bottomPlane), topPlane);
+        }
+    };
+
+
+    /**
+     * Evaluates the kernel along the row with the given batch type, the remainder of the row with scalars.
+     */
+    template<typename Batch, typename T, template<typename> typename Kernel>
+    auto
+    EvaluateBatchedRow(Kernel<T> const& kernel,
+                       Vector<T> const& start,
+                       Vector<T> const& step,
+                       std::span<T> values) noexcept -> void {
+        size_t i = 0;
+
+        if constexpr (Batch::Width > 1) {
+            Batch const iota = Batch::Iota();
+            std::array const starts { Batch::Broadcast(start[0]), Batch::Broadcast(start[1]), Batch::Broadcast(start[2]) };
+            std::array const steps  { Batch::Broadcast(step[0]),  Batch::Broadcast(step[1]),  Batch::Broadcast(step[2])  };
+
+            for (; i + Batch::Width <= values.size(); i += Batch::Width) {
+                Batch const idx = Batch::Broadcast(static_cast<T>(i)) + iota;
+                kernel(starts[0] + idx * steps[0],
+                       starts[1] + idx * steps[1],
+                       starts[2] + idx * steps[2]).Store(std::next(values.data(), i));
+            }
+        }
+
+        using Scalar = Simd::ScalarBatch<T>;
+        for (; i < values.size(); i++) {
+            auto const idx = static_cast<T>(i);
+            kernel(Scalar { start[0] + idx * step[0] },
+                   Scalar { start[1] + idx * step[1] },
+                   Scalar { start[2] + idx * step[2] }).Store(std::next(values.data(), i));
+        }
+    }
+
+    /**
+     * Evaluates the kernel along the row with the widest instruction set of the host CPU.
+     * Instantiated for the four kernels in single and double precision.
+     */
+    template<typename T, template<typename> typename Kernel>
+    auto
+    EvaluateRow(Kernel<T> const& kernel,
+                Vector<T> const& start,
+                Vector<T> const& step,
+                std::span<T> values) noexcept -> void;
+
+    /**
+     * Largest deviation of the kernels of the given instruction set from the double precision scalar path on a fixed
+     * set of sample rows, relative to the tolerance stated above. Values up to 1 are within tolerance.
+     */
+    [[nodiscard]] auto
+    GetRelativeDeviation(Simd::InstructionSet instructionSet) noexcept -> double;
+
+    /** Kernels compiled for AVX2 (ShapeKernelsAvx2.cpp), only called if the host supports it */
+    namespace Avx2 {
+        template<typename T, template<typename> typename Kernel>
+        auto
+        EvaluateRow(Kernel<T> const& kernel,
+                    Vector<T> const& start,
+                    Vector<T> const& step,
+                    std::span<T> values) noexcept -> void;
+    }
+
+    /** Kernels compiled for AVX-512 (ShapeKernelsAvx512.cpp), only called if the host supports it */
+    namespace Avx512 {
+        template<typename T, template<typename> typename Kernel>
+        auto
+        EvaluateRow(Kernel<T> const& kernel,
+                    Vector<T> const& start,
+                    Vector<T> const& step,
+                    std::span<T> values) noexcept -> void;
+    }
+}
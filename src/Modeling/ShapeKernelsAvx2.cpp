@@ -0,0 +1,23 @@
+// compiled with AVX2 enabled (see src/CMakeLists.txt); only entered after a runtime check of the host CPU
+#ifdef UP_SIMD_DISPATCH
+
+#include "ShapeKernels.h"
+
+template<typename T, template<typename> typename Kernel>
+auto ShapeKernels::Avx2::EvaluateRow(Kernel<T> const& kernel,
+                                     Vector<T> const& start,
+                                     Vector<T> const& step,
+                                     std::span<T> values) noexcept -> void {
+    EvaluateBatchedRow<Simd::NativeBatch<T>>(kernel, start, step, values);
+}
+
+template auto ShapeKernels::Avx2::EvaluateRow(SphereKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::Avx2::EvaluateRow(BoxKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::Avx2::EvaluateRow(ConeKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::Avx2::EvaluateRow(CylinderKernel<float> const&, Vector<float> const&, Vector<float> const&, std::span<float>) noexcept -> void;
+template auto ShapeKernels::Avx2::EvaluateRow(SphereKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
+template auto ShapeKernels::Avx2::EvaluateRow(BoxKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
+template auto ShapeKernels::Avx2::EvaluateRow(ConeKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
+template auto ShapeKernels::Avx2::EvaluateRow(CylinderKernel<double> const&, Vector<double> const&, Vector<double> const&, std::span<double>) noexcept -> void;
+
+#endif
@@ -5,6 +5,7 @@
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
 #include <vtkTypeInt16Array.h>
+#include <vtkUnsignedCharArray.h>
 
 #include <highfive/highfive.hpp>
 
@@ -104,7 +105,8 @@ auto HdfImageReader::ReadImageBatch(BatchImages& batchImages) -> void {
                                                      1, std::multiplies{});
 
     using PileDataVectorsVariant = std::variant<std::vector<std::vector<std::vector<float>>>,
-                                                std::vector<std::vector<std::vector<short>>>>;
+                                                std::vector<std::vector<std::vector<short>>>,
+                                                std::vector<std::vector<std::vector<unsigned char>>>>;
     std::vector<PileDataVectorsVariant> pileDataVectors { ArrayNames.size() };
     std::ranges::transform(std::as_const(ArrayNames),
                            pileDataVectors.begin(),
@@ -114,10 +116,12 @@ auto HdfImageReader::ReadImageBatch(BatchImages& batchImages) -> void {
                                auto const vtkTypeAttribute = dataSet.getAttribute("vtkType");
                                auto const vtkDataType = vtkTypeAttribute.read<int>();
 
-                               std::variant<float, short> dataTypeHolderVariant = [vtkDataType]() -> std::variant<float, short> {
+                               using DataTypeHolderVariant = std::variant<float, short, unsigned char>;
+                               DataTypeHolderVariant dataTypeHolderVariant = [vtkDataType]() -> DataTypeHolderVariant {
                                    switch (vtkDataType) {
                                        case VTK_FLOAT: return static_cast<float>(0);
                                        case VTK_SHORT: return static_cast<short>(0);
+                                       case VTK_UNSIGNED_CHAR: return static_cast<unsigned char>(0);
                                        default: throw std::runtime_error("vtk data type not supported");
                                    }
                                }();
@@ -159,7 +163,9 @@ auto HdfImageReader::ReadImageBatch(BatchImages& batchImages) -> void {
                     vtkFloatArray,
                     std::conditional_t<std::is_same_v<ValueType, short>,
                             vtkTypeInt16Array,
-                            nullptr_t>>;
+                            std::conditional_t<std::is_same_v<ValueType, unsigned char>,
+                                    vtkUnsignedCharArray,
+                                    nullptr_t>>>;
 
             auto imageVectorsViewIt = std::ranges::views::join(pileDataVector).begin();
             for (int j = 0; j < batchImages.size(); j++, ++imageVectorsViewIt) {
@@ -6,6 +6,7 @@
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
 #include <vtkTypeInt16Array.h>
+#include <vtkUnsignedCharArray.h>
 
 #include <highfive/highfive.hpp>
 
@@ -82,12 +83,13 @@ auto HdfImageWriter::InitializeFile(HighFive::File& file) const -> void {
             throw std::runtime_error("abstract array must not be null");
 
         int const vtkDataType = abstractArray->GetDataType();
-        using H5Type = std::variant<AtomicType<float>, AtomicType<short>>;
+        using H5Type = std::variant<AtomicType<float>, AtomicType<short>, AtomicType<unsigned char>>;
 
         H5Type h5Type = [vtkDataType]() -> H5Type {
             switch (vtkDataType) {
                 case VTK_FLOAT: return AtomicType<float> {};
                 case VTK_SHORT: return AtomicType<short> {};
+                case VTK_UNSIGNED_CHAR: return AtomicType<unsigned char> {};
                 default: throw std::runtime_error("vtk data type not supported");
             }
         }();
@@ -104,6 +106,8 @@ auto HdfImageWriter::InitializeFile(HighFive::File& file) const -> void {
 
     HighFive::DataSpace const sampleIdsAttributeDataSpace { TotalNumberOfImages };
     file.createAttribute("sample ids", sampleIdsAttributeDataSpace, GetSampleIdDataType());
+    file.createAttribute("noise seeds", sampleIdsAttributeDataSpace, AtomicType<uint64_t> {});
+    file.createAttribute("noise seed derivation", NoiseSeedDerivation);
 
     std::vector<int> const imageExtent { image.GetExtent(), std::next(image.GetExtent(), 6) };
     std::vector<double> const imageSpacing { image.GetSpacing(), std::next(image.GetSpacing(), 3) };
@@ -135,7 +139,16 @@ auto HdfImageWriter::WriteImageBatch(HighFive::File const& file) -> void {
 
     sampleIdsAttribute.write_raw(sampleIdsBuffer.data(), GetSampleIdDataType());
 
-    using ImageDataVectors = std::variant<std::vector<std::vector<float>>, std::vector<std::vector<short>>>;
+    // the seed of each image is stored at the index of its sample id
+    auto noiseSeedsAttribute = file.getAttribute("noise seeds");
+    auto noiseSeeds = noiseSeedsAttribute.read<std::vector<uint64_t>>();
+    std::ranges::copy(std::views::transform(Batch, &BatchImage::NoiseSeed),
+                      std::next(noiseSeeds.begin(), NumberOfProcessedImages));
+    noiseSeedsAttribute.write(noiseSeeds);
+
+    using ImageDataVectors = std::variant<std::vector<std::vector<float>>,
+                                         std::vector<std::vector<short>>,
+                                         std::vector<std::vector<unsigned char>>>;
     using ImagesDataVectors = std::vector<ImageDataVectors>;
     ImagesDataVectors imagesDataVectors { ArrayNames.size() };
     std::ranges::transform(std::as_const(ArrayNames),
@@ -150,12 +163,14 @@ auto HdfImageWriter::WriteImageBatch(HighFive::File const& file) -> void {
                                    throw std::runtime_error("abstract array must not be null");
 
                                int const vtkDataType = abstractArray->GetDataType();
-                               std::variant<vtkFloatArray*, vtkTypeInt16Array*> arrayPointerVariant
-                                       = [vtkDataType, abstractArray]() -> std::variant<vtkFloatArray*, vtkTypeInt16Array*> {
+                               using ArrayPointerVariant = std::variant<vtkFloatArray*, vtkTypeInt16Array*, vtkUnsignedCharArray*>;
+                               ArrayPointerVariant arrayPointerVariant
+                                       = [vtkDataType, abstractArray]() -> ArrayPointerVariant {
 
                                            switch (vtkDataType) {
                                                case VTK_FLOAT: return vtkFloatArray::SafeDownCast(abstractArray);
                                                case VTK_SHORT: return vtkTypeInt16Array::SafeDownCast(abstractArray);
+                                               case VTK_UNSIGNED_CHAR: return vtkUnsignedCharArray::SafeDownCast(abstractArray);
                                                default: throw std::runtime_error("vtk data type not supported");
                                            }
                                        }();
@@ -43,9 +43,24 @@ public:
         Modified();
     }
 
+    [[nodiscard]] virtual auto
+    GetArrayNames() const noexcept -> std::vector<std::string> const& { return ArrayNames; }
+
+    /** Describes how the noise seeds of the images were derived, stored along with them */
+    virtual auto
+    SetNoiseSeedDerivation(std::string const& derivation) noexcept -> void {
+        if (NoiseSeedDerivation == derivation)
+            return;
+
+        NoiseSeedDerivation = derivation;
+
+        Modified();
+    }
+
     struct BatchImage {
         SampleId Id;
         vtkImageData& ImageData;
+        uint64_t NoiseSeed = 0;
 
         [[nodiscard]] auto
         operator== (BatchImage const& other) const noexcept -> bool {
@@ -104,6 +119,7 @@ private:
 
     std::filesystem::path Filename;
     std::vector<std::string> ArrayNames;
+    std::string NoiseSeedDerivation;
     SampleId MaxSampleId {};
     BatchImages Batch {};
     uint16_t TotalNumberOfImages = 0;
@@ -7,18 +7,24 @@
 #include "IO/ImageScalarsWriter.h"
 #include "IO/HdfImageReader.h"
 #include "IO/HdfImageWriter.h"
+#include "../Artifacts/Image/ImageArtifactConcatenation.h"
 #include "../Artifacts/Pipeline.h"
+#include "../Artifacts/Structure/StructureArtifactContributionCache.h"
+#include "../Modeling/BaseVolumeCache.h"
 #include "../Modeling/CtDataSource.h"
 #include "../Modeling/CtStructureTree.h"
+#include "../Segmentation/ThresholdFilter.h"
 #include "../App.h"
 #include "../Utils/PythonInterpreter.h"
 #include "../Utils/System.h"
 
 #include <vtkDataArray.h>
 #include <vtkFloatArray.h>
+#include <vtkImageAlgorithm.h>
 #include <vtkImageData.h>
 #include <vtkPointData.h>
 #include <vtkTypeInt16Array.h>
+#include <vtkUnsignedCharArray.h>
 
 #include <nlohmann/json.hpp>
 
@@ -71,6 +77,66 @@ auto PipelineGroup::GetParameterSpace() const noexcept -> PipelineParameterSpace
     return *ParameterSpace;
 }
 
+/**
+ * Restricts the pipeline and the threshold filter to the requested arrays for the lifetime of the scope, so that
+ * both leave lean mode even if the image generation throws
+ */
+class LeanModeScope {
+public:
+    LeanModeScope(Pipeline const& pipeline, ThresholdFilter* thresholdFilter,
+                  std::vector<std::string> const& requestedArrays) :
+            LeanPipeline(pipeline),
+            LeanThresholdFilter(thresholdFilter),
+            PreviousArtifactArrayOutput(pipeline.GetArtifactArrayOutput()),
+            OutputSegmentedRadiodensities(thresholdFilter && thresholdFilter->GetOutputSegmentedRadiodensities()) {
+        LeanPipeline.SetRequestedArrays(requestedArrays);
+
+        if (LeanThresholdFilter)
+            LeanThresholdFilter->SetOutputSegmentedRadiodensities(
+                    std::ranges::find(requestedArrays, "Segmented Radiodensities") != requestedArrays.end());
+    }
+
+    LeanModeScope(LeanModeScope const&) = delete;
+    auto operator=(LeanModeScope const&) -> LeanModeScope& = delete;
+
+    ~LeanModeScope() {
+        LeanPipeline.SetArtifactArrayOutput(PreviousArtifactArrayOutput);
+
+        if (LeanThresholdFilter)
+            LeanThresholdFilter->SetOutputSegmentedRadiodensities(OutputSegmentedRadiodensities);
+    }
+
+private:
+    Pipeline const& LeanPipeline;
+    ThresholdFilter* LeanThresholdFilter;
+    Pipeline::ArtifactArrayOutput PreviousArtifactArrayOutput;
+    bool OutputSegmentedRadiodensities;
+};
+
+/**
+ * Releases the memory cached while generating the images of a group once the generation ends, and connects the
+ * pipeline input to the data source again instead of the released base volume
+ */
+class GenerationCacheScope {
+public:
+    GenerationCacheScope(vtkImageAlgorithm& pipelineInput, CtDataSource& dataSource) :
+            PipelineInput(pipelineInput),
+            DataSource(dataSource) {}
+
+    GenerationCacheScope(GenerationCacheScope const&) = delete;
+    auto operator=(GenerationCacheScope const&) -> GenerationCacheScope& = delete;
+
+    ~GenerationCacheScope() {
+        PipelineInput.SetInputConnection(DataSource.GetOutputPort());
+        App::GetInstance().GetBaseVolumeCache().Clear();
+        StructureArtifactContributionCache::GetShared().Clear();
+    }
+
+private:
+    vtkImageAlgorithm& PipelineInput;
+    CtDataSource& DataSource;
+};
+
 auto PipelineGroup::GenerateImages(HdfImageWriter& imageWriter, ProgressEventCallback const& callback) -> void {
     spdlog::trace("Generating images for group {}", GroupId);
     auto const startTime = std::chrono::high_resolution_clock::now();
@@ -89,9 +155,17 @@ auto PipelineGroup::GenerateImages(HdfImageWriter& imageWriter, ProgressEventCal
         }
     }();
     auto& thresholdAlgorithm = app.GetThresholdFilter();
-    in.SetInputConnection(ctDataSource.GetOutputPort());
+    auto const& imageArtifactConcatenation = GetBasePipeline().GetImageArtifactConcatenation();
+    in.SetInputConnection(app.GetBaseVolumeCache().GetOutputPort(ctDataSource));
     thresholdAlgorithm.SetInputConnection(out.GetOutputPort());
 
+    // lean mode: the threshold filter only needs the radiodensities and the feature extraction reads the written
+    // arrays, so only the arrays requested by the image writer are computed and kept for each image
+    std::vector<std::string> const& requestedArrays = imageWriter.GetArrayNames();
+    GenerationCacheScope const generationCacheScope { in, ctDataSource };
+    LeanModeScope const leanModeScope { GetBasePipeline(), ThresholdFilter::SafeDownCast(&thresholdAlgorithm),
+                                        requestedArrays };
+
     HdfImageReadHandles imageReadHandles;
     imageReadHandles.reserve(numberOfStates);
 
@@ -117,12 +191,20 @@ auto PipelineGroup::GenerateImages(HdfImageWriter& imageWriter, ProgressEventCal
                 throw std::runtime_error("State must not be nullptr");
 
             state->Apply();
+            imageArtifactConcatenation.SetNoiseSeed(state->GetNoiseSeed());
             thresholdAlgorithm.Update();
             imageData->ShallowCopy(thresholdAlgorithm.GetOutput());
             thresholdAlgorithm.SetOutput(vtkNew<vtkImageData>());
 
+            vtkPointData* pointData = imageData->GetPointData();
+            for (int arrayIdx = pointData->GetNumberOfArrays() - 1; arrayIdx >= 0; arrayIdx--) {
+                char const* arrayName = pointData->GetArrayName(arrayIdx);
+                if (!arrayName || std::ranges::find(requestedArrays, arrayName) == requestedArrays.end())
+                    pointData->RemoveArray(arrayIdx);
+            }
+
             SampleId const sampleId { GroupId, static_cast<uint16_t>(i) };
-            batchImages.push_back({ sampleId, *imageData });
+            batchImages.push_back({ sampleId, *imageData, state->GetNoiseSeed() });
             imageReadHandles.emplace_back(PipelineGroupList::ImagesFile, sampleId);
 
             i++;
@@ -146,6 +228,7 @@ auto PipelineGroup::GenerateImages(HdfImageWriter& imageWriter, ProgressEventCal
     }
 
     Data.InitialState->Apply();
+    imageArtifactConcatenation.SetNoiseSeed(Data.InitialState->GetNoiseSeed());
 
     Data.Images.Emplace(std::move(imageReadHandles));
 
@@ -158,7 +241,7 @@ auto PipelineGroup::GenerateImages(HdfImageWriter& imageWriter, ProgressEventCal
 PYBIND11_EMBEDDED_MODULE(feature_extraction_cpp, m) {
     namespace py = pybind11;
 
-    enum struct VtkType : uint8_t { SHORT = VTK_SHORT, FLOAT = VTK_FLOAT };
+    enum struct VtkType : uint8_t { SHORT = VTK_SHORT, FLOAT = VTK_FLOAT, UNSIGNED_CHAR = VTK_UNSIGNED_CHAR };
 
     //    py::enum_<VtkType>(m, "VtkType")
     //            .value("Short", VtkType::SHORT)
@@ -168,6 +251,7 @@ PYBIND11_EMBEDDED_MODULE(feature_extraction_cpp, m) {
 
     m.attr("VtkType_Short") = static_cast<uint8_t>(VtkType::SHORT);
     m.attr("VtkType_Float") = static_cast<uint8_t>(VtkType::FLOAT);
+    m.attr("VtkType_UnsignedChar") = static_cast<uint8_t>(VtkType::UNSIGNED_CHAR);
 
     py::class_<vtkImageData, std::unique_ptr<vtkImageData, py::nodelete>>(m, "VtkImageData", py::buffer_protocol())
             .def("get_dimensions", [](vtkImageData& imageData) {
@@ -189,10 +273,12 @@ PYBIND11_EMBEDDED_MODULE(feature_extraction_cpp, m) {
             .def_buffer([](vtkImageData& imageData) -> py::buffer_info {
                 auto* scalarAbstractArray = imageData.GetPointData()->GetScalars();
                 int const vtkDataType = scalarAbstractArray->GetDataType();
-                std::variant<float, short> vtkDataTypeHolder = [vtkDataType]() -> std::variant<float, short> {
+                using VtkDataTypeHolder = std::variant<float, short, unsigned char>;
+                VtkDataTypeHolder vtkDataTypeHolder = [vtkDataType]() -> VtkDataTypeHolder {
                     switch (vtkDataType) {
                         case VTK_FLOAT: return static_cast<float>(0);
                         case VTK_SHORT: return static_cast<short>(0);
+                        case VTK_UNSIGNED_CHAR: return static_cast<unsigned char>(0);
                         default: throw std::runtime_error("vtk data type not supported");
                     }
                 }();
@@ -203,7 +289,9 @@ PYBIND11_EMBEDDED_MODULE(feature_extraction_cpp, m) {
                                                             vtkFloatArray,
                                                             std::conditional_t<std::is_same_v<ValueType, short>,
                                                                                vtkTypeInt16Array,
-                                                                               nullptr_t>>;
+                                                                               std::conditional_t<std::is_same_v<ValueType, unsigned char>,
+                                                                                                  vtkUnsignedCharArray,
+                                                                                                  nullptr_t>>>;
                     auto* scalarArray = VtkArrayType::SafeDownCast(scalarAbstractArray);
                     return py::buffer_info { scalarArray->GetPointer(0), scalarArray->GetNumberOfTuples(), true };
                 }, vtkDataTypeHolder);
@@ -504,21 +592,36 @@ auto PipelineGroup::UpdateParameterSpaceStates() noexcept -> void {
     SpaceStates spaceStateUniquePointers;
     spaceStateUniquePointers.reserve(ParameterSpace->GetNumberOfPipelines());
 
-    for (auto spaceStates = ParameterSpace->GenerateSpaceStates(); auto& state : spaceStates)
+    for (auto spaceStates = ParameterSpace->GenerateSpaceStates(); auto& state : spaceStates) {
+        state.SetNoiseSeed(GetNoiseSeed(GroupId, spaceStateUniquePointers.size()));
+
         spaceStateUniquePointers.emplace_back(std::make_unique<PipelineParameterSpaceState>(std::move(state)));
+    }
 
     Data.States = std::move(spaceStateUniquePointers);
 }
 
+auto PipelineGroup::GetNoiseSeed(uint16_t groupId, uint64_t stateIdx) noexcept -> uint64_t {
+    return (static_cast<uint64_t>(groupId) << 32U) | (stateIdx & 0xFFFF'FFFFULL);
+}
+
 auto PipelineGroup::GetMaxImageBatchSize() -> uint64_t {
     auto const& dataSource = App::GetInstance().GetCtDataSource();
     auto const dimensions = dataSource.GetVolumeNumberOfVoxels();
     uint64_t const numberOfVoxels = std::reduce(dimensions.cbegin(), dimensions.cend(), 1, std::multiplies {});
 
-    auto const imageSizeInBytes = numberOfVoxels * sizeof(float) * 10;
-    auto const applicationMemoryMaxSize = System::GetMaxApplicationMemory();
-
-    uint64_t const maxNumberOfImages = applicationMemoryMaxSize / imageSizeInBytes;
+    // in lean mode an image of a batch only keeps its radiodensities and uint8 segmentation mask.
+    // The base volume with its brick-sparse function values and structure ids (2.5 floats per voxel) and the working
+    // set of the pipeline (intermediate radiodensities, threshold output) are needed once for the whole batch,
+    // as is the structure artifact contribution cache
+    uint64_t const imageSizeInBytes = numberOfVoxels * (sizeof(float) + sizeof(uint8_t));
+    uint64_t const sharedSizeInBytes = numberOfVoxels * sizeof(float) * 8
+            + StructureArtifactContributionCache::GetShared().GetMaxSizeInBytes();
+    uint64_t const applicationMemoryMaxSize = System::GetMaxApplicationMemory();
+
+    uint64_t const maxNumberOfImages = applicationMemoryMaxSize > sharedSizeInBytes
+            ? (applicationMemoryMaxSize - sharedSizeInBytes) / imageSizeInBytes
+            : 0;
 
 //    std::cout << std::format("imageSize (B): {}\napplicationMemoryMaxSize: {}\nmaxNumberImages: {}",
 //                             imageSizeInBytes, applicationMemoryMaxSize, maxNumberOfImages) << std::endl;
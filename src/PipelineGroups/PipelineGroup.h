@@ -99,9 +99,16 @@ public:
         std::reference_wrapper<vtkImageData> Mask;
     };
 
+    /** Human-readable form of GetNoiseSeed, stored with the generated images */
+    static constexpr char const* NoiseSeedDerivation = "(group id << 32) | state index";
+
 private:
     friend class PipelineBatch;
 
+    /** The seed of a sample's noise, reproducible from its id. The state index is not truncated to 16 bits */
+    [[nodiscard]] static auto
+    GetNoiseSeed(uint16_t groupId, uint64_t stateIdx) noexcept -> uint64_t;
+
     [[nodiscard]] static auto
     GetMaxImageBatchSize() -> uint64_t;
 
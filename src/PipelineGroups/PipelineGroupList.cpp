@@ -6,6 +6,7 @@
 #include "IO/HdfImageReader.h"
 #include "../Artifacts/PipelineList.h"
 #include "../Modeling/CtStructureTree.h"
+#include "../Modeling/ImplicitCtDataSource.h"
 #include "../Utils/PythonInterpreter.h"
 #include "../App.h"
 
@@ -98,6 +99,20 @@ auto PipelineGroupList::GenerateImages(ProgressEventCallback const& callback) co
     spdlog::debug("Generating images ...");
     auto const startTime = std::chrono::high_resolution_clock::now();
 
+    // the base volume of all images is sampled once, so its single precision accuracy is checked once as well
+    if (auto* implicitDataSource = ImplicitCtDataSource::SafeDownCast(&App::GetInstance().GetCtDataSource());
+            implicitDataSource && implicitDataSource->GetEvaluationPrecision() == EvaluationPrecision::SINGLE) {
+        auto const report = implicitDataSource->ValidatePrecision();
+        auto const level = report.NumberOfClassificationMismatches > 0
+                ? spdlog::level::warn
+                : spdlog::level::info;
+        spdlog::log(level,
+                    "Single precision evaluation deviates from double precision by at most {} in function values "
+                    "and {} in radiodensities, {} of {} points are assigned to a different structure",
+                    report.MaxFunctionValueDeviation, report.MaxRadiodensityDeviation,
+                    report.NumberOfClassificationMismatches, report.NumberOfPoints);
+    }
+
     std::vector progressList (PipelineGroups.size(), 0.0);
     callback(0.0);
 
@@ -110,6 +125,7 @@ auto PipelineGroupList::GenerateImages(ProgressEventCallback const& callback) co
     imageWriter->SetFilename(ImagesFile);
     imageWriter->SetArrayNames({ "Radiodensities", "Segmentation Mask" });
     imageWriter->SetTotalNumberOfImages(GetNumberOfPipelines());
+    imageWriter->SetNoiseSeedDerivation(PipelineGroup::NoiseSeedDerivation);
 
     for (int i = 0; i < PipelineGroups.size(); i++)
         PipelineGroups[i]->GenerateImages(*imageWriter, ProgressUpdater { i, progressList, callback });
@@ -2,6 +2,7 @@
 
 #include "../Utils/LinearAlgebraTypes.h"
 
+#include <cstdint>
 #include <iterator>
 #include <optional>
 #include <string>
@@ -179,9 +180,17 @@ public:
     [[nodiscard]] auto
     FindSpanStateBySpan(PipelineParameterSpan const& parameterSpan) const -> ParameterSpanState const&;
 
+    /** Seed of the random noise of the sample generated from this state */
+    [[nodiscard]] auto
+    GetNoiseSeed() const noexcept -> uint64_t { return NoiseSeed; }
+
+    auto
+    SetNoiseSeed(uint64_t noiseSeed) noexcept -> void { NoiseSeed = noiseSeed; }
+
 private:
     friend class PipelineParameterSpaceStateModel;
 
     PipelineParameterSpace& ParameterSpace;
     SpanSetStates States;
+    uint64_t NoiseSeed = 0;
 };
@@ -0,0 +1,196 @@
+#include "ConnectedComponents.h"
+
+#include "../Utils/ImageDataUtils.h"
+
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+
+ConnectedComponents::ConnectedComponents(std::span<uint8_t const> mask, std::array<int, 3> const& dimensions,
+                                         Connectivity connectivity) :
+        Mask(mask),
+        PrecedingNeighborOffsets(GetPrecedingNeighborOffsets(dimensions, connectivity)),
+        Parents(mask.size()) {
+    if (mask.size() >= std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error("mask has too many voxels to be labelled");
+
+    if (mask.empty())
+        return;
+
+    // a few slabs of whole slices per thread, so that merging the slab boundaries stays cheap
+    int const numberOfSlabs = std::clamp(4 * vtkSMPTools::GetEstimatedNumberOfThreads(),
+                                         1, std::max(dimensions[2], 1));
+    int const slicesPerSlab = (dimensions[2] + numberOfSlabs - 1) / numberOfSlabs;
+    vtkIdType const rowsPerSlab = static_cast<vtkIdType>(slicesPerSlab) * dimensions[1];
+    ImageDataUtils::Grid const grid { dimensions, { 1.0, 1.0, 1.0 }, {} };
+
+    // label each slab on its own, unions only touch voxels of the slab
+    ImageDataUtils::ForEachTile(grid, [this, &dimensions](ImageDataUtils::Tile const& tile) {
+        for (vtkIdType pointId = tile.GetPointIdBegin(); pointId < tile.GetPointIdEnd(); pointId++)
+            Parents[pointId] = static_cast<uint32_t>(pointId);
+
+        int const minZ = static_cast<int>(tile.RowBegin / dimensions[1]);
+
+        tile.ForEachRow([this, &dimensions, minZ](ImageDataUtils::Row const& row) {
+            for (int x = 0; x < dimensions[0]; x++) {
+                if (vtkIdType const pointId = row.PointId + x; Mask[pointId] != 0)
+                    UnionWithPrecedingNeighbors(pointId, { x, row.Y, row.Z }, dimensions, minZ, false);
+            }
+        });
+    }, rowsPerSlab);
+
+    // merge the components across the first slice of each slab and the last slice of the preceding slab
+    for (int z = slicesPerSlab; z < dimensions[2]; z += slicesPerSlab) {
+        for (int y = 0; y < dimensions[1]; y++) {
+            vtkIdType const rowPointId = (static_cast<vtkIdType>(z) * dimensions[1] + y) * dimensions[0];
+
+            for (int x = 0; x < dimensions[0]; x++) {
+                if (vtkIdType const pointId = rowPointId + x; Mask[pointId] != 0)
+                    UnionWithPrecedingNeighbors(pointId, { x, y, z }, dimensions, z - 1, true);
+            }
+        }
+    }
+
+    // point every voxel directly to its root and count the voxels of each component.
+    // Other slabs may concurrently shorten the paths this slab walks, so parents are accessed atomically
+    std::vector<std::unordered_map<uint32_t, uint32_t>> slabComponentSizes(numberOfSlabs);
+
+    ImageDataUtils::ForEachTile(grid, [this, rowsPerSlab, &slabComponentSizes](ImageDataUtils::Tile const& tile) {
+        auto& componentSizes = slabComponentSizes[tile.RowBegin / rowsPerSlab];
+
+        for (vtkIdType pointId = tile.GetPointIdBegin(); pointId < tile.GetPointIdEnd(); pointId++) {
+            if (Mask[pointId] == 0)
+                continue;
+
+            auto root = static_cast<uint32_t>(pointId);
+            for (uint32_t parent = std::atomic_ref(Parents[root]).load(std::memory_order_relaxed);
+                 parent != root;
+                 parent = std::atomic_ref(Parents[root]).load(std::memory_order_relaxed))
+                root = parent;
+
+            std::atomic_ref(Parents[pointId]).store(root, std::memory_order_relaxed);
+            componentSizes[root]++;
+        }
+    }, rowsPerSlab);
+
+    for (auto const& componentSizes : slabComponentSizes) {
+        for (auto const& [root, size] : componentSizes)
+            ComponentSizes[root] += size;
+    }
+}
+
+auto ConnectedComponents::Clean(std::span<uint8_t> mask, std::array<int, 3> const& dimensions,
+                                Cleanup const& cleanup) -> void {
+    if (cleanup.CleanupMode == Mode::KEEP_ALL)
+        return;
+
+    ConnectedComponents const components { mask, dimensions, cleanup.NeighborConnectivity };
+    auto const& componentSizes = components.GetComponentSizes();
+    if (componentSizes.empty())
+        return;
+
+    // ties are broken by the smallest root, so the kept component does not depend on the hash order
+    uint32_t const largestRoot = std::ranges::max_element(componentSizes, [](auto const& a, auto const& b) {
+        return a.second < b.second || (a.second == b.second && a.first > b.first);
+    })->first;
+
+    auto keepComponent = [&cleanup, &componentSizes, largestRoot](uint32_t root) -> bool {
+        switch (cleanup.CleanupMode) {
+            case Mode::KEEP_LARGEST: return root == largestRoot;
+            case Mode::REMOVE_SMALL: return componentSizes.at(root) >= cleanup.MinNumberOfVoxels;
+            default: return true;
+        }
+    };
+
+    ImageDataUtils::Grid const grid { dimensions, { 1.0, 1.0, 1.0 }, {} };
+    ImageDataUtils::ForEachTile(grid, [mask, &components, &keepComponent](ImageDataUtils::Tile const& tile) {
+        // consecutive voxels mostly belong to the same component
+        uint32_t currentRoot = std::numeric_limits<uint32_t>::max();
+        bool keepCurrentComponent = true;
+
+        for (vtkIdType pointId = tile.GetPointIdBegin(); pointId < tile.GetPointIdEnd(); pointId++) {
+            if (mask[pointId] == 0)
+                continue;
+
+            if (uint32_t const root = components.GetRoot(pointId); root != currentRoot) {
+                currentRoot = root;
+                keepCurrentComponent = keepComponent(root);
+            }
+
+            if (!keepCurrentComponent)
+                mask[pointId] = 0;
+        }
+    });
+}
+
+auto ConnectedComponents::GetPrecedingNeighborOffsets(std::array<int, 3> const& dimensions,
+                                                      Connectivity connectivity) -> std::vector<NeighborOffset> {
+    int const maxNumberOfNonZeroOffsets = [connectivity] {
+        switch (connectivity) {
+            case Connectivity::FACES:    return 1;
+            case Connectivity::EDGES:    return 2;
+            case Connectivity::VERTICES: return 3;
+            default: throw std::runtime_error("invalid connectivity");
+        }
+    }();
+
+    vtkIdType const sliceSize = static_cast<vtkIdType>(dimensions[0]) * dimensions[1];
+
+    // the neighbors that come before a voxel in x fastest order, the others see the voxel as their preceding neighbor
+    std::vector<NeighborOffset> offsets;
+    for (int z = -1; z <= 0; z++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int x = -1; x <= 1; x++) {
+                bool const isPreceding = z < 0 || (z == 0 && (y < 0 || (y == 0 && x < 0)));
+                int const numberOfNonZeroOffsets = (x != 0) + (y != 0) + (z != 0);
+
+                if (isPreceding && numberOfNonZeroOffsets <= maxNumberOfNonZeroOffsets)
+                    offsets.push_back({ x, y, z, z * sliceSize + static_cast<vtkIdType>(y) * dimensions[0] + x });
+            }
+        }
+    }
+
+    return offsets;
+}
+
+auto ConnectedComponents::Find(uint32_t pointId) noexcept -> uint32_t {
+    // path halving
+    while (Parents[pointId] != pointId) {
+        Parents[pointId] = Parents[Parents[pointId]];
+        pointId = Parents[pointId];
+    }
+
+    return pointId;
+}
+
+auto ConnectedComponents::Union(uint32_t pointId, uint32_t otherPointId) noexcept -> void {
+    uint32_t const root = Find(pointId);
+    uint32_t const otherRoot = Find(otherPointId);
+
+    // the smaller point id becomes the root
+    if (root < otherRoot)
+        Parents[otherRoot] = root;
+    else if (otherRoot < root)
+        Parents[root] = otherRoot;
+}
+
+auto ConnectedComponents::UnionWithPrecedingNeighbors(vtkIdType pointId, std::array<int, 3> const& coordinates,
+                                                      std::array<int, 3> const& dimensions, int minZ,
+                                                      bool onlyPreviousSlice) noexcept -> void {
+    for (auto const& [ offsetX, offsetY, offsetZ, pointOffset ] : PrecedingNeighborOffsets) {
+        if (onlyPreviousSlice && offsetZ == 0)
+            continue;
+
+        int const x = coordinates[0] + offsetX;
+        int const y = coordinates[1] + offsetY;
+        int const z = coordinates[2] + offsetZ;
+        if (x < 0 || x >= dimensions[0] || y < 0 || y >= dimensions[1] || z < minZ)
+            continue;
+
+        if (vtkIdType const neighborId = pointId + pointOffset; Mask[neighborId] != 0)
+            Union(static_cast<uint32_t>(pointId), static_cast<uint32_t>(neighborId));
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vtkType.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * Connected components of the foreground (non-zero) voxels of a segmentation mask, x fastest.
+ * The mask is labelled by a parallel union-find over slabs of slices whose boundary slices are merged afterwards.
+ * Each voxel is labelled with the root of its component, which is the component's smallest point id.
+ */
+class ConnectedComponents {
+public:
+    enum struct Connectivity : uint8_t {
+        FACES = 6,
+        EDGES = 18,
+        VERTICES = 26
+    };
+
+    enum struct Mode : uint8_t {
+        KEEP_ALL = 0,
+        KEEP_LARGEST,
+        REMOVE_SMALL
+    };
+
+    struct Cleanup {
+        Mode CleanupMode = Mode::KEEP_ALL;
+        Connectivity NeighborConnectivity = Connectivity::FACES;
+        uint32_t MinNumberOfVoxels = 0; // smaller components are removed in REMOVE_SMALL mode
+
+        [[nodiscard]] auto
+        operator==(Cleanup const&) const noexcept -> bool = default;
+    };
+
+    ConnectedComponents(std::span<uint8_t const> mask, std::array<int, 3> const& dimensions,
+                        Connectivity connectivity);
+
+    /** The root of the component of a foreground voxel */
+    [[nodiscard]] auto
+    GetRoot(vtkIdType pointId) const noexcept -> uint32_t { return Parents[pointId]; }
+
+    /** The number of voxels of each component by its root */
+    [[nodiscard]] auto
+    GetComponentSizes() const noexcept -> std::unordered_map<uint32_t, uint32_t> const& { return ComponentSizes; }
+
+    /** Removes the voxels of the components the cleanup does not keep from the mask */
+    auto static
+    Clean(std::span<uint8_t> mask, std::array<int, 3> const& dimensions, Cleanup const& cleanup) -> void;
+
+private:
+    struct NeighborOffset {
+        int X;
+        int Y;
+        int Z;
+        vtkIdType PointOffset;
+    };
+
+    [[nodiscard]] auto static
+    GetPrecedingNeighborOffsets(std::array<int, 3> const& dimensions,
+                                Connectivity connectivity) -> std::vector<NeighborOffset>;
+
+    [[nodiscard]] auto
+    Find(uint32_t pointId) noexcept -> uint32_t;
+
+    auto
+    Union(uint32_t pointId, uint32_t otherPointId) noexcept -> void;
+
+    auto
+    UnionWithPrecedingNeighbors(vtkIdType pointId, std::array<int, 3> const& coordinates,
+                                std::array<int, 3> const& dimensions, int minZ, bool onlyPreviousSlice) noexcept
+                                -> void;
+
+    std::span<uint8_t const> Mask;
+    std::vector<NeighborOffset> PrecedingNeighborOffsets;
+    std::vector<uint32_t> Parents;
+    std::unordered_map<uint32_t, uint32_t> ComponentSizes;
+};
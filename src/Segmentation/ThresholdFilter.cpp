@@ -1,20 +1,20 @@
 #include "ThresholdFilter.h"
 
-#include "../Utils/vtkImageDataArrayIterator.h"
+#include "../Utils/ImageDataUtils.h"
+#include "../Utils/Simd.h"
 
 #include <QComboBox>
 #include <QDoubleSpinBox>
 #include <QFormLayout>
+#include <QSpinBox>
 
 #include <vtkFloatArray.h>
 #include <vtkImageData.h>
-#include <vtkImageIterator.h>
-#include <vtkImageProgressIterator.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
-#include <vtkTypeInt16Array.h>
+#include <vtkUnsignedCharArray.h>
 
 vtkStandardNewMacro(ThresholdFilter);
 
@@ -22,95 +22,155 @@ ThresholdFilter::ThresholdFilter() {
     ThresholdByUpper(500.0);
     ReplaceOut = 1;
     OutValue = -1001.0;
+    SetOutputScalarTypeToFloat();
 }
 
-template<typename IT, typename OT>
-void ThresholdFilterExecute(ThresholdFilter* self, vtkImageData* inData, vtkImageData* outData,
-                            int outExt[6], int id, IT*, OT*) {
+[[nodiscard]] auto static
+ClampToFloat(double value) noexcept -> float {
+    return static_cast<float>(std::clamp(value, static_cast<double>(VTK_FLOAT_MIN), static_cast<double>(VTK_FLOAT_MAX)));
+}
 
-    vtkImageDataArrayIterator<IT> inIt(inData, outExt, "Radiodensities");
-    vtkImageDataArrayIterator<vtkTypeInt16> maskIt(inData, outExt, "Segmentation Mask");
-    vtkImageProgressIterator<OT> outIt(outData, outExt, self, id);
+/** Threshold parameters, clamped to the range of the float radiodensities */
+struct ThresholdParameters {
+    float LowerThreshold;
+    float UpperThreshold;
+    float InValue;
+    float OutValue;
+    bool ReplaceIn;
+    bool ReplaceOut;
+
+    explicit ThresholdParameters(ThresholdFilter& self) :
+            LowerThreshold(ClampToFloat(self.GetLowerThreshold())),
+            UpperThreshold(ClampToFloat(self.GetUpperThreshold())),
+            InValue(ClampToFloat(self.GetInValue())),
+            OutValue(ClampToFloat(self.GetOutValue())),
+            ReplaceIn(self.GetReplaceIn() != 0),
+            ReplaceOut(self.GetReplaceOut() != 0) {}
+};
+
+struct ThresholdArrays {
+    float const* Radiodensities;
+    uint8_t* Mask;
+    float* SegmentedRadiodensities; // nullptr if not output
+};
+
+/** Thresholds the Batch::Width radiodensities starting at the given point */
+template<typename Batch>
+auto ThresholdBatch(ThresholdParameters const& parameters, ThresholdArrays const& arrays,
+                    vtkIdType pointId) noexcept -> void {
+    Batch const values = Batch::Load(std::next(arrays.Radiodensities, pointId));
+    typename Batch::Mask const isWithinBounds = Simd::And(
+            LessEqual(Batch::Broadcast(parameters.LowerThreshold), values),
+            LessEqual(values, Batch::Broadcast(parameters.UpperThreshold)));
+
+    uint32_t const bits = Batch::ToBits(isWithinBounds);
+    uint8_t* const mask = std::next(arrays.Mask, pointId);
+    for (size_t i = 0; i < Batch::Width; i++)
+        mask[i] = static_cast<uint8_t>((bits >> i) & 1U);
+
+    if (!arrays.SegmentedRadiodensities)
+        return;
+
+    Batch const inValues  = parameters.ReplaceIn  ? Batch::Broadcast(parameters.InValue)  : values;
+    Batch const outValues = parameters.ReplaceOut ? Batch::Broadcast(parameters.OutValue) : values;
+    Select(isWithinBounds, inValues, outValues).Store(std::next(arrays.SegmentedRadiodensities, pointId));
+}
 
-    int const replaceIn = self->GetReplaceIn();
-    int const replaceOut = self->GetReplaceOut();
+int ThresholdFilter::RequestData(vtkInformation* vtkNotUsed(request),
+                                 vtkInformationVector** inputVector,
+                                 vtkInformationVector* outputVector) {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+    vtkImageData* output = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+    auto* radiodensityArray = vtkFloatArray::SafeDownCast(input->GetPointData()->GetAbstractArray("Radiodensities"));
+    if (!radiodensityArray) {
+        vtkErrorMacro("input must have a float array \"Radiodensities\"");
+        return 0;
+    }
 
-    IT const lowerThreshold = std::clamp(self->GetLowerThreshold(),
-                                         inData->GetScalarTypeMin(), inData->GetScalarTypeMax());
-    IT const upperThreshold = std::clamp(self->GetUpperThreshold(),
-                                         inData->GetScalarTypeMin(), inData->GetScalarTypeMax());
+    // the output shares all input arrays, only the mask and the segmented radiodensities are allocated
+    output->SetExtent(input->GetExtent());
+    output->GetPointData()->PassData(input->GetPointData());
+
+    vtkIdType const numberOfPoints = input->GetNumberOfPoints();
+
+    vtkNew<vtkUnsignedCharArray> const maskArray;
+    maskArray->SetName("Segmentation Mask");
+    maskArray->SetNumberOfComponents(1);
+    maskArray->SetNumberOfTuples(numberOfPoints);
+    output->GetPointData()->AddArray(maskArray);
+
+    vtkNew<vtkFloatArray> const segmentedRadiodensityArray;
+    if (OutputSegmentedRadiodensities) {
+        segmentedRadiodensityArray->SetName("Segmented Radiodensities");
+        segmentedRadiodensityArray->SetNumberOfComponents(1);
+        segmentedRadiodensityArray->SetNumberOfTuples(numberOfPoints);
+        output->GetPointData()->AddArray(segmentedRadiodensityArray);
+        output->GetPointData()->SetActiveScalars("Segmented Radiodensities");
+    } else
+        output->GetPointData()->SetActiveScalars("Radiodensities");
+
+    // with a cleanup the segmented radiodensities are derived from the cleaned mask afterwards
+    bool const cleanMask = ComponentCleanup.CleanupMode != ConnectedComponents::Mode::KEEP_ALL;
+
+    ThresholdParameters const parameters { *this };
+    ThresholdArrays const arrays { radiodensityArray->GetPointer(0),
+                                   maskArray->GetPointer(0),
+                                   OutputSegmentedRadiodensities && !cleanMask
+                                           ? segmentedRadiodensityArray->GetPointer(0)
+                                           : nullptr };
+
+    ImageDataUtils::Grid const grid { *output };
+    ImageDataUtils::ForEachTile(grid, [this, &parameters, &arrays](ImageDataUtils::Tile const& tile) {
+        CheckAbort();
+
+        if (GetAbortOutput())
+            return;
+
+        vtkIdType pointId = tile.GetPointIdBegin();
+        vtkIdType const endPointId = tile.GetPointIdEnd();
+
+        using Batch = Simd::NativeBatch<float>;
+        if constexpr (Batch::Width > 1) {
+            for (; pointId + static_cast<vtkIdType>(Batch::Width) <= endPointId; pointId += Batch::Width)
+                ThresholdBatch<Batch>(parameters, arrays, pointId);
+        }
 
-    OT const inValue  = std::clamp(self->GetInValue(),  inData->GetScalarTypeMin(), inData->GetScalarTypeMax());
-    OT const outValue = std::clamp(self->GetOutValue(), inData->GetScalarTypeMin(), inData->GetScalarTypeMax());
+        for (; pointId < endPointId; pointId++)
+            ThresholdBatch<Simd::ScalarBatch<float>>(parameters, arrays, pointId);
+    });
 
-    for (; !outIt.IsAtEnd(); inIt.NextSpan(), maskIt.NextSpan(), outIt.NextSpan()) {
-        IT* inSI = inIt.BeginSpan();
-        OT* outSI = outIt.BeginSpan();
-        vtkTypeInt16* maskSI = maskIt.BeginSpan();
-        OT* outSIEnd = outIt.EndSpan();
+    if (!cleanMask || GetAbortOutput())
+        return 1;
 
-        for (; outSI != outSIEnd; ++inSI, ++maskSI, ++outSI) {
-            IT const value = *inSI;
-            bool const valueIsWithinBounds = lowerThreshold <= value && value <= upperThreshold;
+    ConnectedComponents::Clean({ arrays.Mask, static_cast<size_t>(numberOfPoints) }, grid.Dimensions,
+                               ComponentCleanup);
 
-            *maskSI = valueIsWithinBounds
-                    ? 1
-                    : 0;
+    if (!OutputSegmentedRadiodensities)
+        return 1;
 
-            *outSI = valueIsWithinBounds
-                    ? (replaceIn  ? inValue  : static_cast<OT>(value))
-                    : replaceOut ? outValue : static_cast<OT>(value);
-        }
-    }
-}
+    float* const segmentedRadiodensities = segmentedRadiodensityArray->GetPointer(0);
+    ImageDataUtils::ForEachTile(grid, [&parameters, &arrays, segmentedRadiodensities](ImageDataUtils::Tile const& tile) {
+        for (vtkIdType pointId = tile.GetPointIdBegin(); pointId < tile.GetPointIdEnd(); pointId++) {
+            float const value = arrays.Radiodensities[pointId];
 
-template<typename T>
-void ThresholdFilterExecute1(ThresholdFilter* self, vtkImageData* inData, vtkImageData* outData, int outExt[6],
-                             int id, T*) {
-    switch (outData->GetScalarType()) {
-        vtkTemplateMacro(ThresholdFilterExecute(self, inData, outData, outExt, id,
-                                                static_cast<T*>(nullptr), static_cast<VTK_TT*>(nullptr)));
-        default:
-            vtkGenericWarningMacro("Execute: Unknown input ScalarType");
-    }
-}
+            segmentedRadiodensities[pointId] = arrays.Mask[pointId] != 0
+                    ? (parameters.ReplaceIn  ? parameters.InValue  : value)
+                    : (parameters.ReplaceOut ? parameters.OutValue : value);
+        }
+    });
 
-void ThresholdFilter::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
-                                          vtkInformationVector** vtkNotUsed(inputVector),
-                                          vtkInformationVector* vtkNotUsed(outputVector),
-                                          vtkImageData*** inData, vtkImageData** outData, int outExt[6], int id) {
-    switch (inData[0][0]->GetScalarType()) {
-        vtkTemplateMacro(ThresholdFilterExecute1(this, inData[0][0], outData[0], outExt, id,
-                                                 static_cast<VTK_TT*>(nullptr)));
-        default:
-            vtkErrorMacro(<< "Execute: Unknown input ScalarType");
-    }
+    return 1;
 }
 
-void ThresholdFilter::PrepareImageData(vtkInformationVector** inputVector, vtkInformationVector* outputVector,
-                                       vtkImageData*** inDataObjects, vtkImageData** outDataObjects) {
-
-    vtkInformation* info = inputVector[0]->GetInformationObject(0);
-    vtkImageData* inData = vtkImageData::SafeDownCast(info->Get(vtkDataObject::DATA_OBJECT()));
-
-    vtkNew<vtkTypeInt16Array> const segmentationMaskArray;
-    segmentationMaskArray->SetNumberOfComponents(1);
-    segmentationMaskArray->SetName("Segmentation Mask");
-    segmentationMaskArray->SetNumberOfTuples(inData->GetNumberOfPoints());
-    segmentationMaskArray->FillValue(0);
-    inData->GetPointData()->AddArray(segmentationMaskArray);
-
-    vtkNew<vtkFloatArray> const segmentedRadiodensitiesArray;
-    segmentedRadiodensitiesArray->SetNumberOfComponents(1);
-    segmentedRadiodensitiesArray->SetName("Segmented Radiodensities");
-    segmentedRadiodensitiesArray->SetNumberOfTuples(inData->GetNumberOfPoints());
-    segmentedRadiodensitiesArray->FillValue(0.0F);
-    inData->GetPointData()->AddArray(segmentedRadiodensitiesArray);
-    inData->GetPointData()->SetActiveScalars("Segmented Radiodensities");
-
-    vtkThreadedImageAlgorithm::PrepareImageData(inputVector, outputVector, inDataObjects, outDataObjects);
+auto ThresholdFilter::SetComponentCleanup(ConnectedComponents::Cleanup const& cleanup) -> void {
+    if (cleanup == ComponentCleanup)
+        return;
 
-    inData->GetPointData()->SetActiveScalars("Radiodensities");
+    ComponentCleanup = cleanup;
+    Modified();
 }
 
 auto ThresholdFilterWidget::FilterModeToString(FilterMode mode) -> std::string {
@@ -124,11 +184,32 @@ auto ThresholdFilterWidget::FilterModeToString(FilterMode mode) -> std::string {
     }();
 }
 
+auto ThresholdFilterWidget::CleanupModeToString(ConnectedComponents::Mode mode) -> std::string {
+    switch (mode) {
+        case ConnectedComponents::Mode::KEEP_ALL:     return "Keep All";
+        case ConnectedComponents::Mode::KEEP_LARGEST: return "Keep Largest";
+        case ConnectedComponents::Mode::REMOVE_SMALL: return "Remove Small";
+        default: throw std::runtime_error("invalid cleanup mode");
+    }
+}
+
+auto ThresholdFilterWidget::ConnectivityToString(ConnectedComponents::Connectivity connectivity) -> std::string {
+    switch (connectivity) {
+        case ConnectedComponents::Connectivity::FACES:    return "6 (Faces)";
+        case ConnectedComponents::Connectivity::EDGES:    return "18 (Edges)";
+        case ConnectedComponents::Connectivity::VERTICES: return "26 (Vertices)";
+        default: throw std::runtime_error("invalid connectivity");
+    }
+}
+
 ThresholdFilterWidget::ThresholdFilterWidget() :
         FLayout(new QFormLayout(this)),
         ModeComboBox(new QComboBox()),
         LowerThresholdSpinBox(new QDoubleSpinBox()),
-        UpperThresholdSpinBox(new QDoubleSpinBox()) {
+        UpperThresholdSpinBox(new QDoubleSpinBox()),
+        CleanupModeComboBox(new QComboBox()),
+        ConnectivityComboBox(new QComboBox()),
+        MinComponentSizeSpinBox(new QSpinBox()) {
 
     FLayout->setHorizontalSpacing(20);
     FLayout->setContentsMargins({});
@@ -151,13 +232,39 @@ ThresholdFilterWidget::ThresholdFilterWidget() :
     FLayout->addRow("Lower Threshold", LowerThresholdSpinBox);
     FLayout->addRow("Upper Threshold", UpperThresholdSpinBox);
 
+    for (auto const mode : { ConnectedComponents::Mode::KEEP_ALL,
+                             ConnectedComponents::Mode::KEEP_LARGEST,
+                             ConnectedComponents::Mode::REMOVE_SMALL })
+        CleanupModeComboBox->addItem(QString::fromStdString(CleanupModeToString(mode)), QVariant::fromValue(mode));
+
+    for (auto const connectivity : { ConnectedComponents::Connectivity::FACES,
+                                     ConnectedComponents::Connectivity::EDGES,
+                                     ConnectedComponents::Connectivity::VERTICES })
+        ConnectivityComboBox->addItem(QString::fromStdString(ConnectivityToString(connectivity)),
+                                      QVariant::fromValue(connectivity));
+
+    MinComponentSizeSpinBox->setRange(1, 1000000);
+    MinComponentSizeSpinBox->setSingleStep(10);
+    MinComponentSizeSpinBox->setValue(100);
+    MinComponentSizeSpinBox->setSuffix(" voxels");
+
+    FLayout->addRow("Components", CleanupModeComboBox);
+    FLayout->addRow("Connectivity", ConnectivityComboBox);
+    FLayout->addRow("Min. Component Size", MinComponentSizeSpinBox);
+
     connect(ModeComboBox, &QComboBox::currentIndexChanged, this, &ThresholdFilterWidget::UpdateSpinBoxVisibility);
+    connect(CleanupModeComboBox, &QComboBox::currentIndexChanged,
+            this, &ThresholdFilterWidget::UpdateCleanupVisibility);
 
     connect(LowerThresholdSpinBox, &QDoubleSpinBox::valueChanged, this, &ThresholdFilterWidget::DataChanged);
     connect(UpperThresholdSpinBox, &QDoubleSpinBox::valueChanged, this, &ThresholdFilterWidget::DataChanged);
     connect(ModeComboBox, &QComboBox::currentIndexChanged, this, &ThresholdFilterWidget::DataChanged);
+    connect(CleanupModeComboBox, &QComboBox::currentIndexChanged, this, &ThresholdFilterWidget::DataChanged);
+    connect(ConnectivityComboBox, &QComboBox::currentIndexChanged, this, &ThresholdFilterWidget::DataChanged);
+    connect(MinComponentSizeSpinBox, &QSpinBox::valueChanged, this, &ThresholdFilterWidget::DataChanged);
 
     UpdateSpinBoxVisibility(0);
+    UpdateCleanupVisibility(0);
 }
 
 void ThresholdFilterWidget::UpdateSpinBoxVisibility(int /*idx*/) {
@@ -181,9 +288,17 @@ void ThresholdFilterWidget::UpdateSpinBoxVisibility(int /*idx*/) {
         Q_EMIT DataChanged();
 }
 
+void ThresholdFilterWidget::UpdateCleanupVisibility(int /*idx*/) {
+    auto const mode = CleanupModeComboBox->currentData().value<ConnectedComponents::Mode>();
+
+    FLayout->setRowVisible(ConnectivityComboBox, mode != ConnectedComponents::Mode::KEEP_ALL);
+    FLayout->setRowVisible(MinComponentSizeSpinBox, mode == ConnectedComponents::Mode::REMOVE_SMALL);
+}
+
 auto ThresholdFilterWidget::Populate(ThresholdFilter& thresholdFilter) const -> void {
     auto const lower = static_cast<float>(thresholdFilter.GetLowerThreshold());
     auto const upper = static_cast<float>(thresholdFilter.GetUpperThreshold());
+    ConnectedComponents::Cleanup const cleanup = thresholdFilter.GetComponentCleanup();
 
     bool const hasLower = lower > VTK_FLOAT_MIN;
     bool const hasUpper = upper < VTK_FLOAT_MAX;
@@ -205,6 +320,12 @@ auto ThresholdFilterWidget::Populate(ThresholdFilter& thresholdFilter) const ->
 
     if (hasUpper)
         UpperThresholdSpinBox->setValue(upper);
+
+    CleanupModeComboBox->setCurrentIndex(CleanupModeComboBox->findData(QVariant::fromValue(cleanup.CleanupMode)));
+    ConnectivityComboBox->setCurrentIndex(
+            ConnectivityComboBox->findData(QVariant::fromValue(cleanup.NeighborConnectivity)));
+    if (cleanup.CleanupMode == ConnectedComponents::Mode::REMOVE_SMALL)
+        MinComponentSizeSpinBox->setValue(static_cast<int>(cleanup.MinNumberOfVoxels));
 }
 
 auto ThresholdFilterWidget::SetFilterData(ThresholdFilter& thresholdFilter) const -> void {
@@ -217,4 +338,8 @@ auto ThresholdFilterWidget::SetFilterData(ThresholdFilter& thresholdFilter) cons
         case FilterMode::BETWEEN: thresholdFilter.ThresholdBetween(lower, upper); break;
         default: break;
     }
+
+    thresholdFilter.SetComponentCleanup({ CleanupModeComboBox->currentData().value<ConnectedComponents::Mode>(),
+                                          ConnectivityComboBox->currentData().value<ConnectedComponents::Connectivity>(),
+                                          static_cast<uint32_t>(MinComponentSizeSpinBox->value()) });
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ConnectedComponents.h"
+
 #include <QWidget>
 
 #include <vtkImageThreshold.h>
@@ -7,7 +9,14 @@
 class QComboBox;
 class QDoubleSpinBox;
 class QFormLayout;
-
+class QSpinBox;
+
+/**
+ * Thresholds the "Radiodensities" of its input into a new output.
+ * The output shares the input's arrays and adds a uint8 "Segmentation Mask" and, unless disabled,
+ * the thresholded "Segmented Radiodensities" as active scalars. The input is not modified.
+ * Speckles can be removed from the mask by a cleanup of its connected components.
+ */
 class ThresholdFilter : public vtkImageThreshold {
 public:
     ThresholdFilter(const ThresholdFilter&) = delete;
@@ -16,16 +25,26 @@ public:
     static ThresholdFilter* New();
     vtkTypeMacro(ThresholdFilter, vtkImageThreshold);
 
+    vtkSetMacro(OutputSegmentedRadiodensities, bool);
+    vtkGetMacro(OutputSegmentedRadiodensities, bool);
+    vtkBooleanMacro(OutputSegmentedRadiodensities, bool);
+
+    auto
+    SetComponentCleanup(ConnectedComponents::Cleanup const& cleanup) -> void;
+
+    [[nodiscard]] auto
+    GetComponentCleanup() const noexcept -> ConnectedComponents::Cleanup { return ComponentCleanup; }
+
 protected:
     ThresholdFilter();
     ~ThresholdFilter() override = default;
 
-    void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
-                             vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
-                             int outExt[6], int id) override;
+    int RequestData(vtkInformation* request,
+                    vtkInformationVector** inputVector,
+                    vtkInformationVector* outputVector) override;
 
-    void PrepareImageData(vtkInformationVector** inputVector, vtkInformationVector* outputVector,
-                          vtkImageData*** inDataObjects, vtkImageData** outDataObjects) override;
+    bool OutputSegmentedRadiodensities = true;
+    ConnectedComponents::Cleanup ComponentCleanup;
 };
 
 
@@ -54,6 +73,8 @@ Q_SIGNALS:
 private Q_SLOTS:
     void UpdateSpinBoxVisibility(int idx);
 
+    void UpdateCleanupVisibility(int idx);
+
 private:
     [[nodiscard]] auto static
     FilterModeToString(FilterMode mode) -> std::string;
@@ -61,8 +82,17 @@ private:
     [[nodiscard]] auto consteval static
     NumberOfFilterModes() noexcept -> uint8_t { return 3; }
 
+    [[nodiscard]] auto static
+    CleanupModeToString(ConnectedComponents::Mode mode) -> std::string;
+
+    [[nodiscard]] auto static
+    ConnectivityToString(ConnectedComponents::Connectivity connectivity) -> std::string;
+
     QFormLayout* FLayout;
     QComboBox* ModeComboBox;
     QDoubleSpinBox* LowerThresholdSpinBox;
     QDoubleSpinBox* UpperThresholdSpinBox;
+    QComboBox* CleanupModeComboBox;
+    QComboBox* ConnectivityComboBox;
+    QSpinBox* MinComponentSizeSpinBox;
 };
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include <vtkImageData.h>
 #include <vtkPointData.h>
 #include <vtkTypeInt16Array.h>
+#include <vtkUnsignedCharArray.h>
 
 #include <span>
 
@@ -134,23 +135,33 @@ auto ParameterSpaceStateRenderWidget::UpdateSample(std::optional<SampleId> sampl
         auto const numberOfPoints = CurrentImage->GetNumberOfPoints();
 
         auto* radiodensityArray = vtkFloatArray::SafeDownCast(CurrentImage->GetPointData()->GetScalars());
-        auto* maskArray = vtkTypeInt16Array::SafeDownCast(CurrentImage->GetPointData()->GetArray("Segmentation Mask"));
+        auto* maskAbstractArray = CurrentImage->GetPointData()->GetArray("Segmentation Mask");
 
-        if (!radiodensityArray || !maskArray)
+        if (!radiodensityArray || !maskAbstractArray)
             throw std::runtime_error("arrays may not be null");
 
         auto* radiodensities = radiodensityArray->WritePointer(0, numberOfPoints);
-        auto* mask = maskArray->WritePointer(0, numberOfPoints);
-
         std::span const radiodensitySpan { radiodensities, std::next(radiodensities, numberOfPoints) };
-        std::span const maskSpan { mask, std::next(mask, numberOfPoints) };
-
-        std::transform(radiodensitySpan.begin(), radiodensitySpan.end(),
-                       maskSpan.begin(),
-                       radiodensitySpan.begin(),
-                       [](float const& radiodensity, vtkTypeInt16 const& maskValue) {
-            return maskValue == 0 ? -1000.0 : radiodensity;
-        });
+
+        auto applyMask = [&radiodensitySpan, numberOfPoints](auto* maskArray) {
+            auto* mask = maskArray->GetPointer(0);
+            std::span const maskSpan { mask, std::next(mask, numberOfPoints) };
+
+            std::transform(radiodensitySpan.begin(), radiodensitySpan.end(),
+                           maskSpan.begin(),
+                           radiodensitySpan.begin(),
+                           [](float const& radiodensity, auto const& maskValue) {
+                return maskValue == 0 ? -1000.0 : radiodensity;
+            });
+        };
+
+        // masks are uint8, images written by earlier versions have int16 masks
+        if (auto* maskArray = vtkUnsignedCharArray::SafeDownCast(maskAbstractArray))
+            applyMask(maskArray);
+        else if (auto* int16MaskArray = vtkTypeInt16Array::SafeDownCast(maskAbstractArray))
+            applyMask(int16MaskArray);
+        else
+            throw std::runtime_error("mask type not supported");
 
         UpdateImageAlgorithm(*CurrentImage);
     }
@@ -2,6 +2,7 @@
 
 #include "PipelinesWidget.h"
 #include "../../Modeling/CtDataSource.h"
+#include "../../Modeling/ImplicitCtDataSource.h"
 #include "../../Artifacts/Pipeline.h"
 #include "../../Artifacts/PipelineList.h"
 #include "../../App.h"
@@ -51,17 +52,41 @@ auto ArtifactsWidget::UpdateDataSource() const -> void {
 
 ArtifactRenderWidget::ArtifactRenderWidget(PipelineList& pipelines, QWidget*) :
         Pipeline_(nullptr) {
-    pipelines.AddTreeEventCallback([&] { Render(); });
+
+    PreviewDataSource->SetProgressive(true);
+    PreviewDataSource->SetRefinementCallback([this] {
+        QMetaObject::invokeMethod(this, [this] {
+            if (PreviewDataSource->ApplyRefinement())
+                Render();
+        }, Qt::QueuedConnection);
+    });
+
+    pipelines.AddTreeEventCallback([&] {
+        PreviewDataSource->ResetRefinement();
+        Render();
+    });
+}
+
+ArtifactRenderWidget::~ArtifactRenderWidget() {
+    // the preview data source may outlive this widget through the render pipeline
+    PreviewDataSource->SetRefinementCallback({});
 }
 
-ArtifactRenderWidget::~ArtifactRenderWidget() = default;
+auto ArtifactRenderWidget::GetPreviewDataSource() -> CtDataSource& {
+    auto& app = App::GetInstance();
+    auto& ctDataSource = app.GetCtDataSource();
+    if (app.GetCtDataSourceType() != App::CtDataSourceType::IMPLICIT)
+        return ctDataSource;
+
+    PreviewDataSource->CopyParameters(dynamic_cast<ImplicitCtDataSource&>(ctDataSource));
+    return *PreviewDataSource;
+}
 
 auto ArtifactRenderWidget::UpdateDataSource() -> void {
     if (!Pipeline_)
         return;
 
     auto& app = App::GetInstance();
-    auto& ctDataSource = app.GetCtDataSource();
     auto const [in, out] = [this, &app] {
         switch (app.GetCtDataSourceType()) {
             case App::CtDataSourceType::IMPLICIT: return Pipeline_->GetArtifactsAlgorithm();
@@ -69,7 +94,7 @@ auto ArtifactRenderWidget::UpdateDataSource() -> void {
             default: throw std::runtime_error("invalid data source type");
         }
     }();
-    in.SetInputConnection(ctDataSource.GetOutputPort());
+    in.SetInputConnection(GetPreviewDataSource().GetOutputPort());
 
     UpdateImageAlgorithm(out);
 }
@@ -78,7 +103,6 @@ auto ArtifactRenderWidget::UpdateImageArtifactFiltersOnPipelineChange(Pipeline c
     Pipeline_ = &newPipeline;
 
     auto& app = App::GetInstance();
-    auto& ctDataSource = app.GetCtDataSource();
     auto const [in, out] = [&newPipeline, &app] {
         switch (app.GetCtDataSourceType()) {
             case App::CtDataSourceType::IMPLICIT: return newPipeline.GetArtifactsAlgorithm();
@@ -86,7 +110,7 @@ auto ArtifactRenderWidget::UpdateImageArtifactFiltersOnPipelineChange(Pipeline c
             default: throw std::runtime_error("invalid data source type");
         }
     }();
-    in.SetInputConnection(ctDataSource.GetOutputPort());
+    in.SetInputConnection(GetPreviewDataSource().GetOutputPort());
 
     UpdateImageAlgorithm(out);
 }
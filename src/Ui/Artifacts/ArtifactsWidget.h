@@ -4,9 +4,13 @@
 
 #include <QMainWindow>
 
+#include <vtkNew.h>
+
 class QPushButton;
 
 class ArtifactRenderWidget;
+class CtDataSource;
+class ImplicitCtDataSource;
 class Pipeline;
 class PipelineList;
 class PipelinesWidget;
@@ -42,5 +46,9 @@ public Q_SLOTS:
     UpdateImageArtifactFiltersOnPipelineChange(Pipeline const& newPipeline) -> void;
 
 private:
+    [[nodiscard]] auto
+    GetPreviewDataSource() -> CtDataSource&;
+
     Pipeline const* Pipeline_;
+    vtkNew<ImplicitCtDataSource> PreviewDataSource; // progressive copy of the app's implicit data source
 };
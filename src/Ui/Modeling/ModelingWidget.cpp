@@ -35,6 +35,14 @@ ModelingWidget::ModelingWidget(CtStructureTree& ctStructureTree, QWidget* parent
         PhysicalDimensionsSpinBoxes(new DoubleCoordinateRowWidget({ 1.0, 100.0, 1.0, 1.0  }, "Physical\nDimensions")),
         ResolutionSpinBoxes(new IntegerCoordinateRowWidget({ 16, 512, 1, 16 }, "Resolution")) {
 
+    PreviewDataSource->SetProgressive(true);
+    PreviewDataSource->SetRefinementCallback([this] {
+        QMetaObject::invokeMethod(this, [this] {
+            if (PreviewDataSource->ApplyRefinement())
+                RenderingWidget->Render();
+        }, Qt::QueuedConnection);
+    });
+
     ctStructureTree.AddTreeEventCallback([&](CtStructureTreeEvent const&) { RenderingWidget->Render(); });
 
     setCentralWidget(RenderingWidget);
@@ -75,29 +83,47 @@ ModelingWidget::ModelingWidget(CtStructureTree& ctStructureTree, QWidget* parent
 
     connect(PhysicalDimensionsSpinBoxes, &DoubleCoordinateRowWidget::ValueChanged, this, [this] {
         CurrentDataSource->SetVolumeDataPhysicalDimensions(PhysicalDimensionsSpinBoxes->GetRowData(0).ToFloatArray());
+        SyncPreviewDataSource();
     });
     connect(ResolutionSpinBoxes, &IntegerCoordinateRowWidget::ValueChanged, this, [this] {
         CurrentDataSource->SetVolumeNumberOfVoxels(ResolutionSpinBoxes->GetRowData(0).ToArray());
+        SyncPreviewDataSource();
     });
 
     UpdateDataSource(*CurrentDataSource);
 }
 
+ModelingWidget::~ModelingWidget() {
+    // the preview data source may outlive this widget through the render pipeline
+    PreviewDataSource->SetRefinementCallback({});
+}
+
 auto ModelingWidget::UpdateDataSource(CtDataSource& dataSource) -> void {
     CurrentDataSource = &dataSource;
     DataSourceWidget_->UpdateDataSource(dataSource);
 
-    RenderingWidget->UpdateImageAlgorithm(*CurrentDataSource);
+    SyncPreviewDataSource();
+
+    if (dynamic_cast<ImplicitCtDataSource*>(CurrentDataSource))
+        RenderingWidget->UpdateImageAlgorithm(*PreviewDataSource);
+    else
+        RenderingWidget->UpdateImageAlgorithm(*CurrentDataSource);
 
     SyncSpinBoxes();
 }
 
 void ModelingWidget::showEvent(QShowEvent* event) {
     SyncSpinBoxes();
+    SyncPreviewDataSource();
 
     QWidget::showEvent(event);
 }
 
+auto ModelingWidget::SyncPreviewDataSource() const -> void {
+    if (auto const* implicitDataSource = dynamic_cast<ImplicitCtDataSource*>(CurrentDataSource))
+        PreviewDataSource->CopyParameters(*implicitDataSource);
+}
+
 auto ModelingWidget::SyncSpinBoxes() const -> void {
     PhysicalDimensionsSpinBoxes->SetRowData(
             0, DoubleCoordinateRowWidget::RowData { CurrentDataSource->GetVolumeDataPhysicalDimensions() });
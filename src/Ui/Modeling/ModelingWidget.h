@@ -2,6 +2,7 @@
 
 #include <QMainWindow>
 
+#include <vtkNew.h>
 #include <vtkSmartPointer.h>
 
 struct BasicStructureData;
@@ -31,6 +32,7 @@ class ModelingWidget : public QMainWindow {
 
 public:
     explicit ModelingWidget(CtStructureTree& ctStructureTree, QWidget* parent = nullptr);
+    ~ModelingWidget() override;
 
     auto
     UpdateDataSource(CtDataSource& dataSource) -> void;
@@ -42,7 +44,11 @@ private:
     auto
     SyncSpinBoxes() const -> void;
 
+    auto
+    SyncPreviewDataSource() const -> void;
+
     CtDataSource* CurrentDataSource;
+    vtkNew<ImplicitCtDataSource> PreviewDataSource; // progressive copy of the current implicit data source
 
     RenderWidget* const RenderingWidget;
     DataSourceWidget* const DataSourceWidget_;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "LinearAlgebraTypes.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+
+/**
+ * Axis-aligned bounding box. A default constructed box is empty.
+ */
+struct BoundingBox {
+    DoublePoint Min { std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max() };
+    DoublePoint Max { std::numeric_limits<double>::lowest(),
+                      std::numeric_limits<double>::lowest(),
+                      std::numeric_limits<double>::lowest() };
+
+    [[nodiscard]] auto
+    IsEmpty() const noexcept -> bool { return Min[0] > Max[0] || Min[1] > Max[1] || Min[2] > Max[2]; }
+
+    auto
+    Extend(DoublePoint const& point) noexcept -> void {
+        for (uint8_t i = 0; i < 3; i++) {
+            Min[i] = std::min(Min[i], point[i]);
+            Max[i] = std::max(Max[i], point[i]);
+        }
+    }
+
+    auto
+    Extend(BoundingBox const& other) noexcept -> void {
+        if (other.IsEmpty())
+            return;
+
+        Extend(other.Min);
+        Extend(other.Max);
+    }
+
+    [[nodiscard]] auto
+    Padded(double padding) const noexcept -> BoundingBox {
+        if (IsEmpty())
+            return *this;
+
+        return { { Min[0] - padding, Min[1] - padding, Min[2] - padding },
+                 { Max[0] + padding, Max[1] + padding, Max[2] + padding } };
+    }
+
+    [[nodiscard]] auto
+    Intersects(BoundingBox const& other) const noexcept -> bool {
+        return Min[0] <= other.Max[0] && other.Min[0] <= Max[0]
+            && Min[1] <= other.Max[1] && other.Min[1] <= Max[1]
+            && Min[2] <= other.Max[2] && other.Min[2] <= Max[2];
+    }
+
+    [[nodiscard]] auto
+    GetCenter() const noexcept -> DoublePoint {
+        return { (Min[0] + Max[0]) * 0.5, (Min[1] + Max[1]) * 0.5, (Min[2] + Max[2]) * 0.5 };
+    }
+};
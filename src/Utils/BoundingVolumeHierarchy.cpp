@@ -0,0 +1,87 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(std::vector<BoundingBox> const& boxes) :
+        ItemIndices(boxes.size()),
+        ItemBounds(boxes) {
+
+    if (boxes.empty())
+        return;
+
+    std::iota(ItemIndices.begin(), ItemIndices.end(), 0);
+
+    Nodes.reserve(2 * boxes.size());
+    Nodes.emplace_back();
+    Build(boxes, 0, 0, static_cast<uint32_t>(boxes.size()));
+}
+
+auto BoundingVolumeHierarchy::Build(std::vector<BoundingBox> const& boxes,
+                                    uint32_t nodeIdx,
+                                    uint32_t begin,
+                                    uint32_t end) -> void {
+    BoundingBox bounds {};
+    BoundingBox centroidBounds {};
+    for (uint32_t i = begin; i < end; i++) {
+        bounds.Extend(boxes[ItemIndices[i]]);
+        centroidBounds.Extend(boxes[ItemIndices[i]].GetCenter());
+    }
+    Nodes[nodeIdx].Bounds = bounds;
+
+    if (end - begin <= MaxItemsPerLeaf) {
+        Nodes[nodeIdx].First = begin;
+        Nodes[nodeIdx].Count = end - begin;
+        return;
+    }
+
+    // median split along the axis with the largest centroid extent
+    std::array<double, 3> const extents { centroidBounds.Max[0] - centroidBounds.Min[0],
+                                          centroidBounds.Max[1] - centroidBounds.Min[1],
+                                          centroidBounds.Max[2] - centroidBounds.Min[2] };
+    auto const axis = static_cast<uint8_t>(std::distance(extents.cbegin(), std::ranges::max_element(extents)));
+
+    uint32_t const middle = begin + (end - begin) / 2;
+    std::nth_element(std::next(ItemIndices.begin(), begin),
+                     std::next(ItemIndices.begin(), middle),
+                     std::next(ItemIndices.begin(), end),
+                     [&boxes, axis](uint32_t a, uint32_t b) {
+        return boxes[a].GetCenter()[axis] < boxes[b].GetCenter()[axis];
+    });
+
+    auto const leftIdx = static_cast<uint32_t>(Nodes.size());
+    Nodes.emplace_back();
+    Nodes.emplace_back();
+    Nodes[nodeIdx].First = leftIdx;
+
+    Build(boxes, leftIdx, begin, middle);
+    Build(boxes, leftIdx + 1, middle, end);
+}
+
+auto BoundingVolumeHierarchy::Query(BoundingBox const& region, std::vector<uint32_t>& items) const -> void {
+    if (Nodes.empty() || region.IsEmpty())
+        return;
+
+    std::array<uint32_t, 64> stack {};
+    uint8_t stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        Node const& node = Nodes[stack[--stackSize]];
+        if (!node.Bounds.Intersects(region))
+            continue;
+
+        if (node.Count == 0) {
+            stack[stackSize++] = node.First;
+            stack[stackSize++] = node.First + 1;
+            continue;
+        }
+
+        for (uint32_t i = node.First; i < node.First + node.Count; i++) {
+            if (ItemBounds[ItemIndices[i]].Intersects(region))
+                items.emplace_back(ItemIndices[i]);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "BoundingBox.h"
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * Static binary bounding volume hierarchy over a set of axis-aligned boxes.
+ * Items are referred to by their index in the vector of boxes the hierarchy was built from.
+ */
+class BoundingVolumeHierarchy {
+public:
+    BoundingVolumeHierarchy() = default;
+    explicit BoundingVolumeHierarchy(std::vector<BoundingBox> const& boxes);
+
+    /** Appends the indices of all items whose box intersects the region to `items` */
+    auto
+    Query(BoundingBox const& region, std::vector<uint32_t>& items) const -> void;
+
+    [[nodiscard]] auto
+    GetBounds() const noexcept -> BoundingBox { return Nodes.empty() ? BoundingBox {} : Nodes.front().Bounds; }
+
+private:
+    struct Node {
+        BoundingBox Bounds;
+        uint32_t First = 0; // first item if leaf, left child otherwise (right child follows it)
+        uint32_t Count = 0; // 0 for inner nodes
+    };
+
+    auto
+    Build(std::vector<BoundingBox> const& boxes, uint32_t nodeIdx, uint32_t begin, uint32_t end) -> void;
+
+    static constexpr uint32_t MaxItemsPerLeaf = 2;
+
+    std::vector<Node> Nodes;
+    std::vector<uint32_t> ItemIndices;
+    std::vector<BoundingBox> ItemBounds;
+};
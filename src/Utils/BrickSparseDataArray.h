@@ -0,0 +1,255 @@
+#pragma once
+
+#include <vtkGenericDataArray.h>
+#include <vtkObjectFactory.h>
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+
+/**
+ * Single-component point data array of an image, stored in bricks of BrickSize^3 values.
+ * Bricks whose values are all equal are stored as a single value, all others densely (x fastest).
+ * Generic consumers can use the array like any other data array. Brick-aware consumers should read it through
+ * ForEachRowSegment or the brick accessors instead, which avoid per-value index arithmetic.
+ * Writing values of distinct bricks from different threads is safe, writing values of the same brick is not.
+ */
+template<typename ValueTypeT>
+class BrickSparseDataArray : public vtkGenericDataArray<BrickSparseDataArray<ValueTypeT>, ValueTypeT> {
+    using GenericDataArrayType = vtkGenericDataArray<BrickSparseDataArray<ValueTypeT>, ValueTypeT>;
+
+public:
+    using SelfType = BrickSparseDataArray<ValueTypeT>;
+    vtkTemplateTypeMacro(SelfType, GenericDataArrayType)
+    using ValueType = typename Superclass::ValueType;
+
+    static BrickSparseDataArray* New() { VTK_STANDARD_NEW_BODY(BrickSparseDataArray<ValueTypeT>); }
+
+    static constexpr int BrickSize = 8;
+    static constexpr int BrickVolume = BrickSize * BrickSize * BrickSize;
+
+    /** Sets the dimensions of the image and fills all bricks uniformly with the given value */
+    auto
+    SetDimensions(std::array<int, 3> dimensions, ValueType value = {}) -> void {
+        this->SetNumberOfComponents(1);
+
+        Dimensions = dimensions;
+        for (int i = 0; i < 3; i++)
+            NumberOfBricks[i] = (Dimensions[i] + BrickSize - 1) / BrickSize;
+
+        UniformValues.assign(GetTotalNumberOfBricks(), value);
+        DenseBricks.clear();
+        DenseBricks.resize(GetTotalNumberOfBricks());
+
+        vtkIdType const numberOfValues = static_cast<vtkIdType>(Dimensions[0]) * Dimensions[1] * Dimensions[2];
+        this->Size = numberOfValues;
+        this->MaxId = numberOfValues - 1;
+        this->DataChanged();
+    }
+
+    [[nodiscard]] auto
+    GetDimensions() const noexcept -> std::array<int, 3> { return Dimensions; }
+
+    [[nodiscard]] auto
+    GetNumberOfBricks() const noexcept -> std::array<int, 3> { return NumberOfBricks; }
+
+    [[nodiscard]] auto
+    GetTotalNumberOfBricks() const noexcept -> vtkIdType {
+        return static_cast<vtkIdType>(NumberOfBricks[0]) * NumberOfBricks[1] * NumberOfBricks[2];
+    }
+
+    [[nodiscard]] auto
+    GetNumberOfDenseBricks() const noexcept -> vtkIdType {
+        return std::ranges::count_if(DenseBricks, [](auto const& brick) { return !brick.empty(); });
+    }
+
+    /** Index of the brick containing the point with the given image coordinates */
+    [[nodiscard]] auto
+    GetBrickIdx(int x, int y, int z) const noexcept -> vtkIdType {
+        return (static_cast<vtkIdType>(z / BrickSize) * NumberOfBricks[1] + y / BrickSize) * NumberOfBricks[0]
+                + x / BrickSize;
+    }
+
+    [[nodiscard]] auto
+    IsUniform(vtkIdType brickIdx) const noexcept -> bool { return DenseBricks[brickIdx].empty(); }
+
+    [[nodiscard]] auto
+    GetUniformValue(vtkIdType brickIdx) const noexcept -> ValueType { return UniformValues[brickIdx]; }
+
+    /** Values of a dense brick (x fastest), empty if the brick is uniform */
+    [[nodiscard]] auto
+    GetBrickValues(vtkIdType brickIdx) const noexcept -> std::span<ValueType const> { return DenseBricks[brickIdx]; }
+
+    auto
+    FillBrick(vtkIdType brickIdx, ValueType value) -> void {
+        UniformValues[brickIdx] = value;
+        DenseBricks[brickIdx] = {};
+    }
+
+    /**
+     * Stores the values of a brick (x fastest). Values outside the image are ignored.
+     * The brick is stored as a single value if all values inside the image are equal.
+     */
+    auto
+    SetBrickValues(vtkIdType brickIdx, std::span<ValueType const, BrickVolume> values) -> void {
+        vtkIdType const xy = static_cast<vtkIdType>(NumberOfBricks[0]) * NumberOfBricks[1];
+        std::array<int, 3> const brick { static_cast<int>(brickIdx % NumberOfBricks[0]),
+                                         static_cast<int>((brickIdx / NumberOfBricks[0]) % NumberOfBricks[1]),
+                                         static_cast<int>(brickIdx / xy) };
+        std::array<int, 3> validSize {};
+        for (int i = 0; i < 3; i++)
+            validSize[i] = std::min(BrickSize, Dimensions[i] - brick[i] * BrickSize);
+
+        ValueType const first = values[0];
+        bool isUniform = true;
+        for (int z = 0; z < validSize[2] && isUniform; z++) {
+            for (int y = 0; y < validSize[1] && isUniform; y++) {
+                auto const row = values.subspan((z * BrickSize + y) * BrickSize, validSize[0]);
+                isUniform = std::ranges::all_of(row, [first](ValueType value) { return value == first; });
+            }
+        }
+
+        if (isUniform) {
+            FillBrick(brickIdx, first);
+            return;
+        }
+
+        DenseBricks[brickIdx].assign(values.begin(), values.end());
+    }
+
+    /**
+     * Calls f(x, length, values, uniformValue) for the consecutive segments of the row (y, z) in [xBegin, xEnd)
+     * that lie in the same brick. values points to the first value of the segment or is nullptr if the brick is
+     * uniform.
+     */
+    template<typename F>
+    auto
+    ForEachRowSegment(int y, int z, int xBegin, int xEnd, F&& f) const -> void {
+        int const localRowOffset = ((z % BrickSize) * BrickSize + y % BrickSize) * BrickSize;
+
+        for (int x = xBegin; x < xEnd;) {
+            int const length = std::min(xEnd, (x / BrickSize + 1) * BrickSize) - x;
+            vtkIdType const brickIdx = GetBrickIdx(x, y, z);
+
+            if (IsUniform(brickIdx))
+                f(x, length, static_cast<ValueType const*>(nullptr), UniformValues[brickIdx]);
+            else
+                f(x, length, &DenseBricks[brickIdx][localRowOffset + x % BrickSize], ValueType {});
+
+            x += length;
+        }
+    }
+
+    void DeepCopy(vtkDataArray* other) override {
+        auto* source = SelfType::SafeDownCast(other);
+        if (!source || source == this) {
+            Superclass::DeepCopy(other);
+            return;
+        }
+
+        vtkAbstractArray::DeepCopy(other);
+        SetDimensions(source->Dimensions);
+        UniformValues = source->UniformValues;
+        DenseBricks = source->DenseBricks;
+    }
+
+    using Superclass::DeepCopy;
+
+    [[nodiscard]] bool HasStandardMemoryLayout() const override { return false; }
+
+    // vtkGenericDataArray interface
+    [[nodiscard]] auto
+    GetValue(vtkIdType valueIdx) const noexcept -> ValueType {
+        auto const [ brickIdx, localIdx ] = GetBrickLocation(valueIdx);
+        return IsUniform(brickIdx)
+                ? UniformValues[brickIdx]
+                : DenseBricks[brickIdx][localIdx];
+    }
+
+    auto
+    SetValue(vtkIdType valueIdx, ValueType value) -> void {
+        auto const [ brickIdx, localIdx ] = GetBrickLocation(valueIdx);
+        auto& brick = DenseBricks[brickIdx];
+        if (brick.empty()) {
+            if (UniformValues[brickIdx] == value)
+                return;
+
+            brick.assign(BrickVolume, UniformValues[brickIdx]);
+        }
+
+        brick[localIdx] = value;
+    }
+
+    auto
+    GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const noexcept -> void { tuple[0] = GetValue(tupleIdx); }
+
+    auto
+    SetTypedTuple(vtkIdType tupleIdx, ValueType const* tuple) -> void { SetValue(tupleIdx, tuple[0]); }
+
+    [[nodiscard]] auto
+    GetTypedComponent(vtkIdType tupleIdx, int /*component*/) const noexcept -> ValueType { return GetValue(tupleIdx); }
+
+    auto
+    SetTypedComponent(vtkIdType tupleIdx, int /*component*/, ValueType value) -> void { SetValue(tupleIdx, value); }
+
+protected:
+    BrickSparseDataArray() = default;
+    ~BrickSparseDataArray() override = default;
+
+    friend GenericDataArrayType;
+
+    /** Arrays sized through the generic interface are treated as images of dimensions (n, 1, 1) */
+    auto
+    AllocateTuples(vtkIdType numberOfTuples) -> bool {
+        if (this->NumberOfComponents != 1)
+            return false;
+
+        if (numberOfTuples != static_cast<vtkIdType>(Dimensions[0]) * Dimensions[1] * Dimensions[2])
+            SetDimensions({ static_cast<int>(numberOfTuples), 1, 1 });
+
+        return true;
+    }
+
+    auto
+    ReallocateTuples(vtkIdType numberOfTuples) -> bool {
+        if (this->NumberOfComponents != 1)
+            return false;
+
+        vtkIdType const oldNumberOfTuples = static_cast<vtkIdType>(Dimensions[0]) * Dimensions[1] * Dimensions[2];
+        if (numberOfTuples == oldNumberOfTuples)
+            return true;
+
+        std::vector<ValueType> values(std::min(numberOfTuples, oldNumberOfTuples));
+        for (vtkIdType i = 0; i < static_cast<vtkIdType>(values.size()); i++)
+            values[i] = GetValue(i);
+
+        SetDimensions({ static_cast<int>(numberOfTuples), 1, 1 });
+        for (vtkIdType i = 0; i < static_cast<vtkIdType>(values.size()); i++)
+            SetValue(i, values[i]);
+
+        return true;
+    }
+
+private:
+    struct BrickLocation {
+        vtkIdType BrickIdx;
+        int LocalIdx;
+    };
+
+    [[nodiscard]] auto
+    GetBrickLocation(vtkIdType valueIdx) const noexcept -> BrickLocation {
+        auto const x = static_cast<int>(valueIdx % Dimensions[0]);
+        auto const y = static_cast<int>((valueIdx / Dimensions[0]) % Dimensions[1]);
+        auto const z = static_cast<int>(valueIdx / (static_cast<vtkIdType>(Dimensions[0]) * Dimensions[1]));
+
+        return { GetBrickIdx(x, y, z),
+                 ((z % BrickSize) * BrickSize + y % BrickSize) * BrickSize + x % BrickSize };
+    }
+
+    std::array<int, 3> Dimensions {};
+    std::array<int, 3> NumberOfBricks {};
+    std::vector<ValueType> UniformValues;
+    std::vector<std::vector<ValueType>> DenseBricks; // empty for uniform bricks
+};
@@ -0,0 +1,48 @@
+#include "CopyOnWriteArray.h"
+
+#include <vtkNew.h>
+#include <vtkPointData.h>
+
+#include <utility>
+
+
+CopyOnWriteArray::CopyOnWriteArray(vtkPointData& pointData, std::string name, vtkIdType numberOfPoints) :
+        PointData(pointData),
+        Name(std::move(name)),
+        NumberOfPoints(numberOfPoints),
+        Array(vtkFloatArray::SafeDownCast(pointData.GetAbstractArray(Name.c_str()))) {}
+
+auto CopyOnWriteArray::GetValues() const noexcept -> float const* {
+    return Array ? Array->GetPointer(0) : nullptr;
+}
+
+auto CopyOnWriteArray::Overwrite() -> OverwritePass {
+    vtkSmartPointer<vtkFloatArray> previousArray = Array;
+    float const* const values = GetValues();
+    float* const writableValues = IsPrivate ? Array->GetPointer(0) : CreatePrivateArray();
+
+    return { std::move(previousArray), values, writableValues };
+}
+
+auto CopyOnWriteArray::GetWritableValues() -> float* {
+    if (!IsPrivate)
+        Apply([](vtkIdType /*pointId*/, float value) { return value; });
+
+    return Array->GetPointer(0);
+}
+
+auto CopyOnWriteArray::AddValues(float const* values) -> void {
+    Apply([values](vtkIdType pointId, float value) { return value + values[pointId]; });
+}
+
+auto CopyOnWriteArray::CreatePrivateArray() -> float* {
+    vtkNew<vtkFloatArray> const array;
+    array->SetNumberOfComponents(1);
+    array->SetName(Name.c_str());
+    array->SetNumberOfTuples(NumberOfPoints);
+    PointData.AddArray(array);
+
+    Array = array;
+    IsPrivate = true;
+    return array->GetPointer(0);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vtkFloatArray.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+
+#include <string>
+
+class vtkPointData;
+
+
+/**
+ * Handle to a float point data array of a filter output whose arrays are passed on from the input by reference.
+ * The array is looked up once; it is only replaced by a private copy in the output when it is first written to,
+ * and the copy is created in the same pass as the first modification.
+ * A missing array is treated as all zeros and only created once it is written to.
+ */
+class CopyOnWriteArray {
+public:
+    CopyOnWriteArray(vtkPointData& pointData, std::string name, vtkIdType numberOfPoints);
+
+    /** Current values, nullptr if the array does not exist yet, i.e. all values are 0 */
+    [[nodiscard]] auto
+    GetValues() const noexcept -> float const*;
+
+    /** Values of the private array of the output, created on first access */
+    [[nodiscard]] auto
+    GetWritableValues() -> float*;
+
+    /** Values read and written by a pass that sets every value of the array */
+    struct OverwritePass {
+        vtkSmartPointer<vtkFloatArray> PreviousArray; // keeps the shared values alive during the pass
+        float const* Values; // nullptr if all values are 0
+        float* WritableValues;
+    };
+
+    /** Makes the array private to the output without initializing it, the caller has to set every value */
+    [[nodiscard]] auto
+    Overwrite() -> OverwritePass;
+
+    /** Sets every value to function(pointId, value), in parallel */
+    template<typename Function>
+    auto
+    Apply(Function function) -> void {
+        OverwritePass const pass = Overwrite();
+        float const* const values = pass.Values;
+        float* const writableValues = pass.WritableValues;
+
+        vtkSMPTools::For(0, NumberOfPoints, [=](vtkIdType pointId, vtkIdType endPointId) {
+            for (; pointId < endPointId; pointId++)
+                writableValues[pointId] = function(pointId, values ? values[pointId] : 0.0F);
+        });
+    }
+
+    /** Adds the given values to the array */
+    auto
+    AddValues(float const* values) -> void;
+
+private:
+    /** Creates the private array without initializing its values and replaces the shared one in the output */
+    [[nodiscard]] auto
+    CreatePrivateArray() -> float*;
+
+    vtkPointData& PointData;
+    std::string Name;
+    vtkIdType NumberOfPoints;
+    vtkSmartPointer<vtkFloatArray> Array;
+    bool IsPrivate = false;
+};
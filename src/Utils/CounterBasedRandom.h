@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+
+/**
+ * Counter-based random numbers (Philox4x32-10, Salmon et al.: "Parallel Random Numbers: As Easy as 1, 2, 3").
+ * The numbers are a pure function of a seed, a stream and an index, e.g. a sample, an artifact and a voxel,
+ * so they can be generated in any order and in parallel, and every value can be regenerated on its own.
+ */
+namespace CounterBasedRandom {
+
+    using Block = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    [[nodiscard]] constexpr auto
+    Philox4x32(Block counter, Key key) noexcept -> Block {
+        constexpr uint32_t multiplier0 = 0xD2511F53;
+        constexpr uint32_t multiplier1 = 0xCD9E8D57;
+        constexpr uint32_t weyl0 = 0x9E3779B9;
+        constexpr uint32_t weyl1 = 0xBB67AE85;
+
+        for (int round = 0; round < 10; round++) {
+            if (round != 0) {
+                key[0] += weyl0;
+                key[1] += weyl1;
+            }
+
+            uint64_t const product0 = static_cast<uint64_t>(multiplier0) * counter[0];
+            uint64_t const product1 = static_cast<uint64_t>(multiplier1) * counter[2];
+
+            counter = { static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                        static_cast<uint32_t>(product1),
+                        static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                        static_cast<uint32_t>(product0) };
+        }
+
+        return counter;
+    }
+
+    /** Random numbers of one stream of a seed, each index yields a block of four values */
+    class Stream {
+    public:
+        constexpr Stream(uint64_t seed, uint32_t streamId) noexcept :
+                SeedKey { static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) },
+                StreamId(streamId) {}
+
+        [[nodiscard]] constexpr auto
+        Bits(uint64_t index) const noexcept -> Block {
+            return Philox4x32({ static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), StreamId, 0 },
+                              SeedKey);
+        }
+
+        /** Four values uniformly distributed in [0, 1) */
+        [[nodiscard]] constexpr auto
+        Uniform(uint64_t index) const noexcept -> std::array<float, 4> {
+            Block const bits = Bits(index);
+            return { ToUnitInterval(bits[0]), ToUnitInterval(bits[1]),
+                     ToUnitInterval(bits[2]), ToUnitInterval(bits[3]) };
+        }
+
+        /** Four values normally distributed with the given mean and standard deviation (Box-Muller transform) */
+        [[nodiscard]] auto
+        Normal(uint64_t index, float mean, float sd) const noexcept -> std::array<float, 4> {
+            Block const bits = Bits(index);
+
+            std::array<float, 4> values {};
+            for (int i = 0; i < 4; i += 2) {
+                float const radius = sd * std::sqrt(-2.0F * std::log(1.0F - ToUnitInterval(bits[i])));
+                float const angle = 2.0F * std::numbers::pi_v<float> * ToUnitInterval(bits[i + 1]);
+
+                values[i] = mean + radius * std::cos(angle);
+                values[i + 1] = mean + radius * std::sin(angle);
+            }
+            return values;
+        }
+
+    private:
+        [[nodiscard]] static constexpr auto
+        ToUnitInterval(uint32_t bits) noexcept -> float {
+            return static_cast<float>(bits >> 8) * 0x1.0p-24F;
+        }
+
+        Key SeedKey;
+        uint32_t StreamId;
+    };
+
+}
@@ -0,0 +1,94 @@
+#include "DistanceTransform.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+auto DistanceTransform::FeatureTransform2D(std::span<uint8_t const> mask,
+                                           std::array<int, 2> dimensions,
+                                           std::array<double, 2> spacing,
+                                           std::span<int32_t> closestFeatures) -> void {
+    auto const [ width, height ] = dimensions;
+    auto const numberOfPixels = static_cast<size_t>(width) * height;
+    if (mask.size() != numberOfPixels || closestFeatures.size() != numberOfPixels)
+        throw std::runtime_error("mask and feature map must match the given dimensions");
+
+    static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    // columns: closest set row of each pixel within its column
+    std::vector<int32_t> closestRows(numberOfPixels, -1);
+    for (int x = 0; x < width; x++) {
+        int32_t lastSetRow = -1;
+        for (int y = 0; y < height; y++) {
+            if (mask[y * width + x])
+                lastSetRow = y;
+            closestRows[y * width + x] = lastSetRow;
+        }
+
+        lastSetRow = -1;
+        for (int y = height - 1; y >= 0; y--) {
+            if (mask[y * width + x])
+                lastSetRow = y;
+
+            int32_t& closestRow = closestRows[y * width + x];
+            if (lastSetRow != -1 && (closestRow == -1 || lastSetRow - y < y - closestRow))
+                closestRow = lastSetRow;
+        }
+    }
+
+    // rows: lower envelope of the parabolas rooted at the column distances
+    double const xWeight = spacing[0] * spacing[0];
+    double const yWeight = spacing[1] * spacing[1];
+    std::vector<double> columnDistances(width);
+    std::vector<int> parabolaSites(width);
+    std::vector<double> parabolaBoundaries(width + 1);
+
+    for (int y = 0; y < height; y++) {
+        int32_t const* const rowClosestRows = &closestRows[y * width];
+        for (int x = 0; x < width; x++) {
+            int const dy = rowClosestRows[x] - y;
+            columnDistances[x] = rowClosestRows[x] == -1 ? infinity : yWeight * dy * dy;
+        }
+
+        auto intersection = [&](int a, int b) {
+            return ((columnDistances[b] + xWeight * b * b) - (columnDistances[a] + xWeight * a * a))
+                    / (2.0 * xWeight * (b - a));
+        };
+
+        int k = -1;
+        for (int q = 0; q < width; q++) {
+            if (columnDistances[q] == infinity)
+                continue;
+
+            double s = -infinity;
+            while (k >= 0) {
+                s = intersection(parabolaSites[k], q);
+                if (s > parabolaBoundaries[k])
+                    break;
+                k--;
+            }
+
+            k++;
+            parabolaSites[k] = q;
+            parabolaBoundaries[k] = k == 0 ? -infinity : s;
+            parabolaBoundaries[k + 1] = infinity;
+        }
+
+        int32_t* const rowFeatures = &closestFeatures[y * width];
+        if (k == -1) {
+            std::fill_n(rowFeatures, width, -1);
+            continue;
+        }
+
+        int j = 0;
+        for (int x = 0; x < width; x++) {
+            while (parabolaBoundaries[j + 1] < x)
+                j++;
+
+            int const site = parabolaSites[j];
+            rowFeatures[x] = rowClosestRows[site] * width + site;
+        }
+    }
+}
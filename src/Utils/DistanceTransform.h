@@ -0,0 +1,21 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+namespace DistanceTransform {
+
+    /**
+     * Exact Euclidean feature transform of a 2D mask (row-major, x fastest) with anisotropic pixel spacing.
+     * Writes for each pixel the index of the closest set pixel, or -1 if no pixel is set.
+     * Separable lower-envelope algorithm by Felzenszwalb and Huttenlocher: linear in the number of pixels.
+     */
+    auto
+    FeatureTransform2D(std::span<uint8_t const> mask,
+                       std::array<int, 2> dimensions,
+                       std::array<double, 2> spacing,
+                       std::span<int32_t> closestFeatures) -> void;
+
+}
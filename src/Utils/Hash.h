@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ranges>
+
+
+namespace Hash {
+
+    /** Mixes the hash of a value into a seed, recursing into ranges such as std::array */
+    template<typename T>
+    auto
+    Combine(std::size_t& seed, T const& value) noexcept -> void {
+        if constexpr (std::ranges::range<T>) {
+            for (auto const& element : value)
+                Combine(seed, element);
+        } else
+            seed ^= std::hash<T> {}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+
+    template<typename... Ts>
+    [[nodiscard]] auto
+    Values(Ts const&... values) noexcept -> std::size_t {
+        std::size_t seed = 0;
+        (Combine(seed, values), ...);
+        return seed;
+    }
+
+}
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "LinearAlgebraTypes.h"
+
 #include <array>
+#include <algorithm>
+#include <utility>
 
+#include <vtkImageData.h>
+#include <vtkSMPTools.h>
 #include <vtkType.h>
 
 [[nodiscard]] auto static
@@ -37,3 +43,111 @@ GetDecrementedCoordinates(std::array<int, 3> const coordinates,
     return decrementedCoordinates;
 }
 
+/**
+ * Tiled iteration over the voxels of an image.
+ * A tile is a block of consecutive whole rows (x fastest) of one or more slices, its rows are handed to the kernel
+ * with their point id and world position, so kernels run a plain loop over x without any per-voxel index arithmetic.
+ */
+namespace ImageDataUtils {
+    /** Voxel grid of an image */
+    struct Grid {
+        std::array<int, 3> Dimensions {};
+        std::array<double, 3> Spacing {};
+        DoublePoint StartPoint {}; // world position of the first voxel
+
+        Grid(std::array<int, 3> const& dimensions, std::array<double, 3> const& spacing,
+             DoublePoint const& startPoint) noexcept :
+                Dimensions(dimensions),
+                Spacing(spacing),
+                StartPoint(startPoint) {}
+
+        explicit Grid(vtkImageData& imageData) {
+            imageData.GetDimensions(Dimensions.data());
+            imageData.GetSpacing(Spacing.data());
+            imageData.GetPoint(0, StartPoint.data());
+        }
+
+        [[nodiscard]] auto
+        GetNumberOfRows() const noexcept -> vtkIdType { return static_cast<vtkIdType>(Dimensions[1]) * Dimensions[2]; }
+
+        [[nodiscard]] auto
+        GetSliceSize() const noexcept -> vtkIdType { return static_cast<vtkIdType>(Dimensions[0]) * Dimensions[1]; }
+    };
+
+    /** Voxels (x, Y, Z) with x in [0, Dimensions[0]) of a grid */
+    struct Row {
+        int Y;
+        int Z;
+        vtkIdType PointId; // point id of voxel (0, Y, Z)
+        DoublePoint StartPoint; // world position of voxel (0, Y, Z)
+    };
+
+    /** The rows [RowBegin, RowEnd) of a grid, the row id of (Y, Z) being Z * Dimensions[1] + Y */
+    struct Tile {
+        Grid const& VoxelGrid;
+        vtkIdType RowBegin;
+        vtkIdType RowEnd;
+
+        [[nodiscard]] auto
+        GetPointIdBegin() const noexcept -> vtkIdType { return RowBegin * VoxelGrid.Dimensions[0]; }
+
+        [[nodiscard]] auto
+        GetPointIdEnd() const noexcept -> vtkIdType { return RowEnd * VoxelGrid.Dimensions[0]; }
+
+        /** Calls function(row) for the rows of the tile in order */
+        template<typename RowFunction>
+        auto
+        ForEachRow(RowFunction&& function) const -> void {
+            auto const& [ dimensions, spacing, startPoint ] = VoxelGrid;
+
+            // the row's coordinates are only decoded once per tile
+            Row row { static_cast<int>(RowBegin % dimensions[1]),
+                      static_cast<int>(RowBegin / dimensions[1]),
+                      GetPointIdBegin(),
+                      {} };
+
+            for (vtkIdType rowId = RowBegin; rowId < RowEnd; rowId++) {
+                row.StartPoint = { startPoint[0],
+                                   startPoint[1] + row.Y * spacing[1],
+                                   startPoint[2] + row.Z * spacing[2] };
+
+                function(std::as_const(row));
+
+                row.PointId += dimensions[0];
+                if (++row.Y == dimensions[1]) {
+                    row.Y = 0;
+                    row.Z++;
+                }
+            }
+        }
+    };
+
+    /** Tiles hold about this many voxels, so that the float arrays a kernel works on stay in the L2 cache */
+    constexpr vtkIdType TileSizeInVoxels = 1 << 15;
+
+    [[nodiscard]] inline auto
+    GetCacheSizedRowsPerTile(Grid const& grid) noexcept -> vtkIdType {
+        return std::max(TileSizeInVoxels / std::max(grid.Dimensions[0], 1), vtkIdType { 1 });
+    }
+
+    /**
+     * Calls function(tile) for the tiles of rowsPerTile rows of the grid, in parallel.
+     * Tiles are cache-sized by default, a multiple of Dimensions[1] rows per tile yields tiles of whole slices.
+     */
+    template<typename TileFunction>
+    auto
+    ForEachTile(Grid const& grid, TileFunction&& function, vtkIdType rowsPerTile = 0) -> void {
+        if (rowsPerTile <= 0)
+            rowsPerTile = GetCacheSizedRowsPerTile(grid);
+
+        vtkIdType const numberOfRows = grid.GetNumberOfRows();
+        vtkIdType const numberOfTiles = (numberOfRows + rowsPerTile - 1) / rowsPerTile;
+
+        vtkSMPTools::For(0, numberOfTiles, 1, [&](vtkIdType tileId, vtkIdType endTileId) {
+            for (; tileId < endTileId; tileId++) {
+                vtkIdType const rowBegin = tileId * rowsPerTile;
+                function(Tile { grid, rowBegin, std::min(rowBegin + rowsPerTile, numberOfRows) });
+            }
+        });
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cmath>
 
 
 using DoubleVector = std::array<double, 3>;
@@ -0,0 +1,46 @@
+#include "Simd.h"
+
+#include <array>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+
+auto Simd::GetHostInstructionSet() noexcept -> InstructionSet {
+    static InstructionSet const instructionSet = [] {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        std::array<int, 4> registers {};
+        __cpuid(registers.data(), 0);
+        if (registers[0] < 7)
+            return InstructionSet::BASELINE;
+
+        __cpuid(registers.data(), 1);
+        bool const osSavesYmm = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x06U) == 0x06U;
+        bool const osSavesZmm = osSavesYmm && (_xgetbv(0) & 0xE0U) == 0xE0U;
+
+        __cpuidex(registers.data(), 7, 0);
+        if (osSavesZmm && (registers[1] & (1 << 16)) != 0)
+            return InstructionSet::AVX512;
+        if (osSavesYmm && (registers[1] & (1 << 5)) != 0)
+            return InstructionSet::AVX2;
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return InstructionSet::AVX512;
+        if (__builtin_cpu_supports("avx2"))
+            return InstructionSet::AVX2;
+#endif
+        return InstructionSet::BASELINE;
+    }();
+
+    return instructionSet;
+}
+
+auto Simd::GetInstructionSetName(InstructionSet instructionSet) noexcept -> char const* {
+    switch (instructionSet) {
+        case InstructionSet::AVX2:   return "AVX2";
+        case InstructionSet::AVX512: return "AVX-512";
+        default:                     return "baseline";
+    }
+}
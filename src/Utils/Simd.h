@@ -0,0 +1,251 @@
+#pragma once
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Simd {
+
+    /**
+     * Instruction sets with dedicated shape kernels, which are selected at runtime (see ShapeKernels::EvaluateRow)
+     */
+    enum struct InstructionSet : uint8_t {
+        BASELINE,
+        AVX2,
+        AVX512
+    };
+
+    /**
+     * Widest instruction set the host CPU (and operating system) supports; BASELINE on other architectures
+     */
+    [[nodiscard]] auto
+    GetHostInstructionSet() noexcept -> InstructionSet;
+
+    [[nodiscard]] auto
+    GetInstructionSetName(InstructionSet instructionSet) noexcept -> char const*;
+
+// Translation units compiled for different instruction sets see different batch types behind the same names,
+// so each instruction set gets its own inline namespace to keep the definitions from colliding at link time.
+#if defined(__AVX512F__)
+inline namespace Avx512 {
+#elif defined(__AVX2__)
+inline namespace Avx2 {
+#else
+inline namespace Baseline {
+#endif
+
+    [[nodiscard]] inline auto
+    And(bool a, bool b) noexcept -> bool { return a && b; }
+
+    template<typename T>
+    struct ScalarBatch {
+        using Mask = bool;
+        static constexpr size_t Width = 1;
+
+        T Value;
+
+        [[nodiscard]] static auto
+        Broadcast(T value) noexcept -> ScalarBatch { return { value }; }
+
+        [[nodiscard]] static auto
+        Iota() noexcept -> ScalarBatch { return { T {} }; }
+
+        auto
+        Store(T* destination) const noexcept -> void { *destination = Value; }
+
+        [[nodiscard]] static auto
+        Load(T const* source) noexcept -> ScalarBatch { return { *source }; }
+
+        /** Bit i of the result is lane i of the mask */
+        [[nodiscard]] static auto
+        ToBits(Mask mask) noexcept -> uint32_t { return mask ? 1U : 0U; }
+
+        friend auto operator+(ScalarBatch a, ScalarBatch b) noexcept -> ScalarBatch { return { a.Value + b.Value }; }
+        friend auto operator-(ScalarBatch a, ScalarBatch b) noexcept -> ScalarBatch { return { a.Value - b.Value }; }
+        friend auto operator*(ScalarBatch a, ScalarBatch b) noexcept -> ScalarBatch { return { a.Value * b.Value }; }
+
+        friend auto Min(ScalarBatch a, ScalarBatch b) noexcept -> ScalarBatch { return { std::min(a.Value, b.Value) }; }
+        friend auto Max(ScalarBatch a, ScalarBatch b) noexcept -> ScalarBatch { return { std::max(a.Value, b.Value) }; }
+        friend auto Sqrt(ScalarBatch a) noexcept -> ScalarBatch { return { std::sqrt(a.Value) }; }
+
+        friend auto LessEqual(ScalarBatch a, ScalarBatch b) noexcept -> Mask { return a.Value <= b.Value; }
+        friend auto Select(Mask mask, ScalarBatch a, ScalarBatch b) noexcept -> ScalarBatch { return mask ? a : b; }
+    };
+
+    /**
+     * Widest batch of the given scalar type supported by the target instruction set
+     */
+    template<typename T>
+    struct NativeBatchType { using Type = ScalarBatch<T>; };
+
+    template<typename T>
+    using NativeBatch = typename NativeBatchType<T>::Type;
+
+#if defined(__AVX512F__)
+
+    [[nodiscard]] inline auto
+    And(__mmask16 a, __mmask16 b) noexcept -> __mmask16 { return static_cast<__mmask16>(a & b); }
+
+    [[nodiscard]] inline auto
+    And(__mmask8 a, __mmask8 b) noexcept -> __mmask8 { return static_cast<__mmask8>(a & b); }
+
+    struct FloatBatch16 {
+        using Mask = __mmask16;
+        static constexpr size_t Width = 16;
+
+        __m512 Value;
+
+        [[nodiscard]] static auto
+        Broadcast(float value) noexcept -> FloatBatch16 { return { _mm512_set1_ps(value) }; }
+
+        [[nodiscard]] static auto
+        Iota() noexcept -> FloatBatch16 {
+            return { _mm512_setr_ps(0.0F, 1.0F,  2.0F,  3.0F,  4.0F,  5.0F,  6.0F,  7.0F,
+                                    8.0F, 9.0F, 10.0F, 11.0F, 12.0F, 13.0F, 14.0F, 15.0F) };
+        }
+
+        auto
+        Store(float* destination) const noexcept -> void { _mm512_storeu_ps(destination, Value); }
+
+        [[nodiscard]] static auto
+        Load(float const* source) noexcept -> FloatBatch16 { return { _mm512_loadu_ps(source) }; }
+
+        [[nodiscard]] static auto
+        ToBits(Mask mask) noexcept -> uint32_t { return mask; }
+
+        friend auto operator+(FloatBatch16 a, FloatBatch16 b) noexcept -> FloatBatch16 { return { _mm512_add_ps(a.Value, b.Value) }; }
+        friend auto operator-(FloatBatch16 a, FloatBatch16 b) noexcept -> FloatBatch16 { return { _mm512_sub_ps(a.Value, b.Value) }; }
+        friend auto operator*(FloatBatch16 a, FloatBatch16 b) noexcept -> FloatBatch16 { return { _mm512_mul_ps(a.Value, b.Value) }; }
+
+        friend auto Min(FloatBatch16 a, FloatBatch16 b) noexcept -> FloatBatch16 { return { _mm512_min_ps(a.Value, b.Value) }; }
+        friend auto Max(FloatBatch16 a, FloatBatch16 b) noexcept -> FloatBatch16 { return { _mm512_max_ps(a.Value, b.Value) }; }
+        friend auto Sqrt(FloatBatch16 a) noexcept -> FloatBatch16 { return { _mm512_sqrt_ps(a.Value) }; }
+
+        friend auto LessEqual(FloatBatch16 a, FloatBatch16 b) noexcept -> Mask { return _mm512_cmp_ps_mask(a.Value, b.Value, _CMP_LE_OQ); }
+        friend auto Select(Mask mask, FloatBatch16 a, FloatBatch16 b) noexcept -> FloatBatch16 { return { _mm512_mask_blend_ps(mask, b.Value, a.Value) }; }
+    };
+
+    struct DoubleBatch8 {
+        using Mask = __mmask8;
+        static constexpr size_t Width = 8;
+
+        __m512d Value;
+
+        [[nodiscard]] static auto
+        Broadcast(double value) noexcept -> DoubleBatch8 { return { _mm512_set1_pd(value) }; }
+
+        [[nodiscard]] static auto
+        Iota() noexcept -> DoubleBatch8 { return { _mm512_setr_pd(0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0) }; }
+
+        auto
+        Store(double* destination) const noexcept -> void { _mm512_storeu_pd(destination, Value); }
+
+        [[nodiscard]] static auto
+        Load(double const* source) noexcept -> DoubleBatch8 { return { _mm512_loadu_pd(source) }; }
+
+        [[nodiscard]] static auto
+        ToBits(Mask mask) noexcept -> uint32_t { return mask; }
+
+        friend auto operator+(DoubleBatch8 a, DoubleBatch8 b) noexcept -> DoubleBatch8 { return { _mm512_add_pd(a.Value, b.Value) }; }
+        friend auto operator-(DoubleBatch8 a, DoubleBatch8 b) noexcept -> DoubleBatch8 { return { _mm512_sub_pd(a.Value, b.Value) }; }
+        friend auto operator*(DoubleBatch8 a, DoubleBatch8 b) noexcept -> DoubleBatch8 { return { _mm512_mul_pd(a.Value, b.Value) }; }
+
+        friend auto Min(DoubleBatch8 a, DoubleBatch8 b) noexcept -> DoubleBatch8 { return { _mm512_min_pd(a.Value, b.Value) }; }
+        friend auto Max(DoubleBatch8 a, DoubleBatch8 b) noexcept -> DoubleBatch8 { return { _mm512_max_pd(a.Value, b.Value) }; }
+        friend auto Sqrt(DoubleBatch8 a) noexcept -> DoubleBatch8 { return { _mm512_sqrt_pd(a.Value) }; }
+
+        friend auto LessEqual(DoubleBatch8 a, DoubleBatch8 b) noexcept -> Mask { return _mm512_cmp_pd_mask(a.Value, b.Value, _CMP_LE_OQ); }
+        friend auto Select(Mask mask, DoubleBatch8 a, DoubleBatch8 b) noexcept -> DoubleBatch8 { return { _mm512_mask_blend_pd(mask, b.Value, a.Value) }; }
+    };
+
+    template<> struct NativeBatchType<float>  { using Type = FloatBatch16; };
+    template<> struct NativeBatchType<double> { using Type = DoubleBatch8; };
+
+#elif defined(__AVX2__)
+
+    [[nodiscard]] inline auto
+    And(__m256 a, __m256 b) noexcept -> __m256 { return _mm256_and_ps(a, b); }
+
+    [[nodiscard]] inline auto
+    And(__m256d a, __m256d b) noexcept -> __m256d { return _mm256_and_pd(a, b); }
+
+    struct FloatBatch8 {
+        using Mask = __m256;
+        static constexpr size_t Width = 8;
+
+        __m256 Value;
+
+        [[nodiscard]] static auto
+        Broadcast(float value) noexcept -> FloatBatch8 { return { _mm256_set1_ps(value) }; }
+
+        [[nodiscard]] static auto
+        Iota() noexcept -> FloatBatch8 { return { _mm256_setr_ps(0.0F, 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F) }; }
+
+        auto
+        Store(float* destination) const noexcept -> void { _mm256_storeu_ps(destination, Value); }
+
+        [[nodiscard]] static auto
+        Load(float const* source) noexcept -> FloatBatch8 { return { _mm256_loadu_ps(source) }; }
+
+        [[nodiscard]] static auto
+        ToBits(Mask mask) noexcept -> uint32_t { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+
+        friend auto operator+(FloatBatch8 a, FloatBatch8 b) noexcept -> FloatBatch8 { return { _mm256_add_ps(a.Value, b.Value) }; }
+        friend auto operator-(FloatBatch8 a, FloatBatch8 b) noexcept -> FloatBatch8 { return { _mm256_sub_ps(a.Value, b.Value) }; }
+        friend auto operator*(FloatBatch8 a, FloatBatch8 b) noexcept -> FloatBatch8 { return { _mm256_mul_ps(a.Value, b.Value) }; }
+
+        friend auto Min(FloatBatch8 a, FloatBatch8 b) noexcept -> FloatBatch8 { return { _mm256_min_ps(a.Value, b.Value) }; }
+        friend auto Max(FloatBatch8 a, FloatBatch8 b) noexcept -> FloatBatch8 { return { _mm256_max_ps(a.Value, b.Value) }; }
+        friend auto Sqrt(FloatBatch8 a) noexcept -> FloatBatch8 { return { _mm256_sqrt_ps(a.Value) }; }
+
+        friend auto LessEqual(FloatBatch8 a, FloatBatch8 b) noexcept -> Mask { return _mm256_cmp_ps(a.Value, b.Value, _CMP_LE_OQ); }
+        friend auto Select(Mask mask, FloatBatch8 a, FloatBatch8 b) noexcept -> FloatBatch8 { return { _mm256_blendv_ps(b.Value, a.Value, mask) }; }
+    };
+
+    struct DoubleBatch4 {
+        using Mask = __m256d;
+        static constexpr size_t Width = 4;
+
+        __m256d Value;
+
+        [[nodiscard]] static auto
+        Broadcast(double value) noexcept -> DoubleBatch4 { return { _mm256_set1_pd(value) }; }
+
+        [[nodiscard]] static auto
+        Iota() noexcept -> DoubleBatch4 { return { _mm256_setr_pd(0.0, 1.0, 2.0, 3.0) }; }
+
+        auto
+        Store(double* destination) const noexcept -> void { _mm256_storeu_pd(destination, Value); }
+
+        [[nodiscard]] static auto
+        Load(double const* source) noexcept -> DoubleBatch4 { return { _mm256_loadu_pd(source) }; }
+
+        [[nodiscard]] static auto
+        ToBits(Mask mask) noexcept -> uint32_t { return static_cast<uint32_t>(_mm256_movemask_pd(mask)); }
+
+        friend auto operator+(DoubleBatch4 a, DoubleBatch4 b) noexcept -> DoubleBatch4 { return { _mm256_add_pd(a.Value, b.Value) }; }
+        friend auto operator-(DoubleBatch4 a, DoubleBatch4 b) noexcept -> DoubleBatch4 { return { _mm256_sub_pd(a.Value, b.Value) }; }
+        friend auto operator*(DoubleBatch4 a, DoubleBatch4 b) noexcept -> DoubleBatch4 { return { _mm256_mul_pd(a.Value, b.Value) }; }
+
+        friend auto Min(DoubleBatch4 a, DoubleBatch4 b) noexcept -> DoubleBatch4 { return { _mm256_min_pd(a.Value, b.Value) }; }
+        friend auto Max(DoubleBatch4 a, DoubleBatch4 b) noexcept -> DoubleBatch4 { return { _mm256_max_pd(a.Value, b.Value) }; }
+        friend auto Sqrt(DoubleBatch4 a) noexcept -> DoubleBatch4 { return { _mm256_sqrt_pd(a.Value) }; }
+
+        friend auto LessEqual(DoubleBatch4 a, DoubleBatch4 b) noexcept -> Mask { return _mm256_cmp_pd(a.Value, b.Value, _CMP_LE_OQ); }
+        friend auto Select(Mask mask, DoubleBatch4 a, DoubleBatch4 b) noexcept -> DoubleBatch4 { return { _mm256_blendv_pd(b.Value, a.Value, mask) }; }
+    };
+
+    template<> struct NativeBatchType<float>  { using Type = FloatBatch8; };
+    template<> struct NativeBatchType<double> { using Type = DoubleBatch4; };
+
+#endif
+
+}
+
+}
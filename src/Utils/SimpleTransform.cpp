@@ -15,7 +15,7 @@ SimpleTransform::SimpleTransform(SimpleTransform const& other) :
         RotationAngles(other.RotationAngles),
         ScaleFactors(other.ScaleFactors),
         Matrix(other.Matrix),
-        InverseMatrix(other.Matrix) {}
+        InverseMatrix(other.InverseMatrix) {}
 
 auto SimpleTransform::GetMTime() const noexcept -> vtkMTimeType {
     return Transform->GetMTime();
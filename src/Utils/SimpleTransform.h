@@ -57,6 +57,12 @@ public:
     auto
     SetData(SimpleTransformData const& transformData) noexcept -> void;
 
+    [[nodiscard]] auto
+    GetMatrix() const noexcept -> RowMajor4x3Matrix const& { return Matrix; }
+
+    [[nodiscard]] auto
+    GetInverseMatrix() const noexcept -> RowMajor4x3Matrix const& { return InverseMatrix; }
+
     [[nodiscard]] inline auto
     TransformPoint(Point const& point) const noexcept -> Point;
 